@@ -0,0 +1,79 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// 替换全局 operator new/delete：计数后转交 malloc/free
+// 对齐版本（align_val_t）不经过这里，不计入统计
+
+namespace {
+
+std::atomic<std::uint64_t> g_count{0};
+std::atomic<std::uint64_t> g_bytes{0};
+
+// 只统计成功的分配
+auto counted_alloc(std::size_t size) noexcept -> void* {
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p != nullptr) {
+        g_count.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    return p;
+}
+
+} // anonymous namespace
+
+namespace fp::bench {
+
+auto alloc_snapshot() noexcept -> AllocStats {
+    return {g_count.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed)};
+}
+
+} // namespace fp::bench
+
+// 与标准 operator new 一致：失败时调用 new-handler 后重试，没有 handler 时抛出 bad_alloc
+auto operator new(std::size_t size) -> void* {
+    void* p = nullptr;
+    while ((p = counted_alloc(size)) == nullptr) {
+        if (auto handler = std::get_new_handler()) {
+            handler();
+        } else {
+            throw std::bad_alloc{};
+        }
+    }
+    return p;
+}
+
+auto operator new[](std::size_t size) -> void* {
+    return ::operator new(size);
+}
+
+// nothrow 版本同样经过 new-handler，失败时返回空指针
+auto operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept -> void* {
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t& tag) noexcept -> void* {
+    return ::operator new(size, tag);
+}
+
+auto operator delete(void* p) noexcept -> void {
+    std::free(p);
+}
+
+auto operator delete[](void* p) noexcept -> void {
+    std::free(p);
+}
+
+auto operator delete(void* p, std::size_t /*size*/) noexcept -> void {
+    std::free(p);
+}
+
+auto operator delete[](void* p, std::size_t /*size*/) noexcept -> void {
+    std::free(p);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace fp::bench {
+
+// 纯数据：进程内累计的堆分配次数与字节数
+struct AllocStats {
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+};
+
+// 链接 alloc_counter.cpp 后，全局 operator new 会累计分配次数与字节数
+// 读取当前累计值；两次快照之差即为其间的分配
+auto alloc_snapshot() noexcept -> AllocStats;
+
+inline auto operator-(AllocStats a, AllocStats b) noexcept -> AllocStats {
+    return {a.count - b.count, a.bytes - b.bytes};
+}
+
+} // namespace fp::bench
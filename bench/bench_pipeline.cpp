@@ -0,0 +1,178 @@
+// 生成器端到端基准：parse_args、各模板 render、各类型 generate_project、write_project
+// 每项输出中位数/p99 延迟与单次操作的分配次数、分配字节数（JSON，字段顺序固定）
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "bench_util.hpp"
+#include "fp-cpp-init/cli.hpp"
+#include "fp-cpp-init/project.hpp"
+#include "fp-cpp-init/render.hpp"
+#include "fp-cpp-init/templates.hpp"
+#include "fp-cpp-init/writer.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 纯数据：参与 render 基准的模板
+const std::pair<const char*, const char*> kTemplates[] = {
+    {"cmake_exe", fp::templates::cmake_exe},
+    {"cmake_lib", fp::templates::cmake_lib},
+    {"cmake_header", fp::templates::cmake_header},
+    {"cmake_examples", fp::templates::cmake_examples},
+    {"cmake_tests", fp::templates::cmake_tests},
+    {"result_hpp", fp::templates::result_hpp},
+    {"main_cpp", fp::templates::main_cpp},
+    {"lib_hpp", fp::templates::lib_hpp},
+    {"lib_cpp", fp::templates::lib_cpp},
+    {"header_only_hpp", fp::templates::header_only_hpp},
+    {"example_cpp", fp::templates::example_cpp},
+    {"test_main_cpp", fp::templates::test_main_cpp},
+    {"gitignore", fp::templates::gitignore},
+    {"clang_format", fp::templates::clang_format},
+    {"clang_tidy", fp::templates::clang_tidy},
+    {"license_mit", fp::templates::license_mit},
+    {"license_apache2", fp::templates::license_apache2},
+    {"license_gpl3", fp::templates::license_gpl3},
+    {"license_bsd3", fp::templates::license_bsd3},
+    {"readme", fp::templates::readme},
+    {"readme_lib", fp::templates::readme_lib},
+    {"github_ci", fp::templates::github_ci},
+    {"github_release", fp::templates::github_release},
+};
+
+constexpr const char* kTypes[] = {"exe", "lib", "header"};
+
+auto make_options(std::string type) -> fp::Options {
+    fp::Options opts;
+    opts.command = fp::Command::New;
+    opts.project_name = "bench-project";
+    opts.type = std::move(type);
+    opts.license = "mit";
+    opts.cpp_std = "20";
+    opts.author = "Bench";
+    opts.description = "Benchmark project";
+    return opts;
+}
+
+// 副作用：基准输出目录，优先使用 tmpfs 以排除磁盘抖动
+auto scratch_root() -> fs::path {
+    std::error_code ec;
+    fs::path base =
+        fs::is_directory("/dev/shm", ec) ? fs::path("/dev/shm") : fs::temp_directory_path();
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    return base / ("fp-cpp-init-bench-" + std::to_string(stamp));
+}
+
+class Runner {
+  public:
+    Runner(size_t samples, std::string_view filter) : samples_(samples), filter_(filter) {}
+
+    // 副作用：测量一项并追加到结果
+    template <typename Op>
+    auto run(const std::string& name, Op&& op) -> void {
+        if (!filter_.empty() && name.find(filter_) == std::string::npos) {
+            return;
+        }
+
+        constexpr size_t alloc_runs = 16;
+        op();
+        auto before = fp::bench::alloc_snapshot();
+        for (size_t i = 0; i < alloc_runs; ++i) {
+            op();
+        }
+        auto allocs = fp::bench::alloc_snapshot() - before;
+
+        auto stats = fp::bench::measure(op, samples_, fp::bench::calibrate(op));
+
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), ",\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f",
+                      static_cast<double>(allocs.count) / alloc_runs,
+                      static_cast<double>(allocs.bytes) / alloc_runs);
+
+        if (!results_.empty()) {
+            results_ += ',';
+        }
+        results_ += "{\"name\":" + fp::json::quote(name) + "," + fp::bench::stats_fields(stats) +
+                    buf + "}";
+    }
+
+    auto json() const -> std::string {
+        return "{\"benchmark\":\"fp-cpp-init-bench\"," + fp::bench::environment_fields() +
+               ",\"results\":[" + results_ + "]}\n";
+    }
+
+  private:
+    size_t samples_;
+    std::string_view filter_;
+    std::string results_;
+};
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t samples = 100;
+    if (auto arg = fp::bench::arg_value(argc, argv, "--samples"); !arg.empty()) {
+        std::from_chars(arg.data(), arg.data() + arg.size(), samples);
+    }
+    Runner runner(samples, fp::bench::arg_value(argc, argv, "--filter"));
+
+    // parse_args（给出 --author，不会启动 git 查询用户名，只测解析本身）
+    std::vector<std::string> args = {"fp-cpp-init", "new",      "bench-project", "--type=lib",
+                                     "--license",   "apache2",  "--std=23",      "--author=Bench",
+                                     "--no-ci"};
+    std::vector<char*> argv_ptrs;
+    for (auto& arg : args) {
+        argv_ptrs.push_back(arg.data());
+    }
+    runner.run("parse_args", [&] {
+        auto result = fp::parse_args(static_cast<int>(argv_ptrs.size()), argv_ptrs.data());
+        fp::bench::do_not_optimize(result);
+    });
+
+    // render
+    auto ctx = fp::make_render_context(make_options("exe"), "2025");
+    for (const auto& [name, tmpl] : kTemplates) {
+        runner.run(std::string("render/") + name, [&, tmpl = tmpl] {
+            auto out = fp::render(tmpl, ctx);
+            fp::bench::do_not_optimize(out);
+        });
+    }
+
+    // generate_project
+    for (const char* type : kTypes) {
+        auto opts = make_options(type);
+        auto type_ctx = fp::make_render_context(opts, "2025");
+        runner.run(std::string("generate_project/") + type, [&] {
+            auto project = fp::generate_project(opts, type_ctx);
+            fp::bench::do_not_optimize(project);
+        });
+    }
+
+    // write_project：每种类型写入独立目录，重复运行时覆盖已有文件
+    auto root = scratch_root();
+    for (const char* type : kTypes) {
+        auto opts = make_options(type);
+        auto project = fp::generate_project(opts, fp::make_render_context(opts, "2025"));
+        auto dir = root / type;
+        runner.run(std::string("write_project/") + type, [&] {
+            auto written = fp::write_project(project, dir);
+            if (written.is_err()) {
+                std::fprintf(stderr, "%s\n", written.error().c_str());
+                std::exit(1);
+            }
+        });
+    }
+    std::error_code ec;
+    fs::remove_all(root, ec);
+
+    return fp::bench::emit(argc, argv, runner.json());
+}
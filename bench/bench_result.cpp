@@ -0,0 +1,253 @@
+// fp::Result 与异常、std::expected 的错误处理开销对比
+// 流水线与生成项目中的 parse_int 相同：解析整数 -> 范围检查 -> 换算
+// 输出 JSON：成功路径与错误路径的单次耗时，以及各实现的代码体积
+
+#include <charconv>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "bench_util.hpp"
+#include "fp-cpp-init/result.hpp"
+
+#if FP_RESULT_HAS_EXPECTED
+#include <expected>
+#endif
+
+// 每个实现放在独立的 ELF 段中，由链接器生成的 __start_/__stop_ 符号得到代码体积
+// 内联进调用方的模板实例计入所在段；其他平台上体积输出为 null
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+#define FP_BENCH_CODE_SIZE 1
+#define FP_BENCH_SECTION(name) __attribute__((section(#name), noinline))
+#define FP_BENCH_DECLARE_SECTION(name)                                                             \
+    extern "C" const char __start_##name[];                                                        \
+    extern "C" const char __stop_##name[];
+#define FP_BENCH_SECTION_SIZE(name) static_cast<long>(__stop_##name - __start_##name)
+#else
+#define FP_BENCH_CODE_SIZE 0
+#if defined(__GNUC__) || defined(__clang__)
+#define FP_BENCH_SECTION(name) __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define FP_BENCH_SECTION(name) __declspec(noinline)
+#else
+#define FP_BENCH_SECTION(name)
+#endif
+#endif
+
+namespace {
+
+constexpr int kMax = 10000;
+
+// 纯函数：from_chars 解析，所有实现共用，保证只比较错误传递方式
+auto parse_digits(std::string_view s, int& out) -> bool {
+    if (s.empty()) {
+        return false;
+    }
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+    return ec == std::errc{} && ptr == s.data() + s.size();
+}
+
+// ============================================
+// fp::Result<int>（std::string 错误）
+// ============================================
+
+FP_BENCH_SECTION(fpbench_result)
+auto result_parse(std::string_view s) -> fp::Result<int> {
+    int value = 0;
+    if (!parse_digits(s, value)) {
+        return fp::Result<int>::err("Invalid integer: '" + std::string(s) + "'");
+    }
+    return fp::Result<int>::ok(value);
+}
+
+FP_BENCH_SECTION(fpbench_result)
+auto result_check(int value) -> fp::Result<int> {
+    if (value < 0 || value > kMax) {
+        return fp::Result<int>::err("Out of range: " + std::to_string(value));
+    }
+    return fp::Result<int>::ok(value);
+}
+
+FP_BENCH_SECTION(fpbench_result)
+auto result_pipeline(std::string_view s) -> int {
+    return result_parse(s).and_then(result_check).map([](int v) { return v * 2; }).value_or(-1);
+}
+
+// ============================================
+// fp::Result<int, StaticError>（无分配错误）
+// ============================================
+
+using StaticResult = fp::Result<int, fp::StaticError>;
+
+FP_BENCH_SECTION(fpbench_static)
+auto static_parse(std::string_view s) -> StaticResult {
+    int value = 0;
+    if (!parse_digits(s, value)) {
+        return StaticResult::err("Invalid integer");
+    }
+    return StaticResult::ok(value);
+}
+
+FP_BENCH_SECTION(fpbench_static)
+auto static_check(int value) -> StaticResult {
+    if (value < 0 || value > kMax) {
+        return StaticResult::err("Out of range");
+    }
+    return StaticResult::ok(value);
+}
+
+FP_BENCH_SECTION(fpbench_static)
+auto static_pipeline(std::string_view s) -> int {
+    return static_parse(s).and_then(static_check).map([](int v) { return v * 2; }).value_or(-1);
+}
+
+// ============================================
+// 异常
+// ============================================
+
+FP_BENCH_SECTION(fpbench_exceptions)
+auto throwing_parse(std::string_view s) -> int {
+    int value = 0;
+    if (!parse_digits(s, value)) {
+        throw std::invalid_argument("Invalid integer: '" + std::string(s) + "'");
+    }
+    return value;
+}
+
+FP_BENCH_SECTION(fpbench_exceptions)
+auto throwing_check(int value) -> int {
+    if (value < 0 || value > kMax) {
+        throw std::out_of_range("Out of range: " + std::to_string(value));
+    }
+    return value;
+}
+
+FP_BENCH_SECTION(fpbench_exceptions)
+auto throwing_pipeline(std::string_view s) -> int {
+    try {
+        return throwing_check(throwing_parse(s)) * 2;
+    } catch (const std::exception&) {
+        return -1;
+    }
+}
+
+// ============================================
+// std::expected（仅 C++23）
+// ============================================
+
+#if FP_RESULT_HAS_EXPECTED
+
+FP_BENCH_SECTION(fpbench_expected)
+auto expected_parse(std::string_view s) -> std::expected<int, std::string> {
+    int value = 0;
+    if (!parse_digits(s, value)) {
+        return std::unexpected("Invalid integer: '" + std::string(s) + "'");
+    }
+    return value;
+}
+
+FP_BENCH_SECTION(fpbench_expected)
+auto expected_check(int value) -> std::expected<int, std::string> {
+    if (value < 0 || value > kMax) {
+        return std::unexpected("Out of range: " + std::to_string(value));
+    }
+    return value;
+}
+
+FP_BENCH_SECTION(fpbench_expected)
+auto expected_pipeline(std::string_view s) -> int {
+    // 不依赖 and_then/transform（需 __cpp_lib_expected >= 202211L）
+    auto parsed = expected_parse(s);
+    if (!parsed) {
+        return -1;
+    }
+    auto checked = expected_check(*parsed);
+    if (!checked) {
+        return -1;
+    }
+    return *checked * 2;
+}
+
+#endif
+
+#if FP_BENCH_CODE_SIZE
+FP_BENCH_DECLARE_SECTION(fpbench_result)
+FP_BENCH_DECLARE_SECTION(fpbench_static)
+FP_BENCH_DECLARE_SECTION(fpbench_exceptions)
+#if FP_RESULT_HAS_EXPECTED
+FP_BENCH_DECLARE_SECTION(fpbench_expected)
+#endif
+#endif
+
+// 成功输入与错误输入（错误路径一半在解析、一半在范围检查失败）
+constexpr std::string_view kGood[] = {"42", "1234", "7", "9999", "500", "8191", "0", "31"};
+constexpr std::string_view kBad[] = {"abc", "99999", "12x", "123456", "", "10001", "-", "77777"};
+
+using Pipeline = int (*)(std::string_view);
+
+struct Entry {
+    const char* name;
+    Pipeline pipeline;
+    long code_size; // < 0 表示未知
+};
+
+// 副作用：对一组输入测量单次调用耗时
+template <size_t N>
+auto run(Pipeline pipeline, const std::string_view (&inputs)[N], size_t samples)
+    -> fp::bench::Stats {
+    size_t next = 0;
+    return fp::bench::measure(
+        [&] {
+            fp::bench::do_not_optimize(pipeline(inputs[next]));
+            next = (next + 1) % N;
+        },
+        samples, 2000);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t samples = 200;
+    if (auto arg = fp::bench::arg_value(argc, argv, "--samples"); !arg.empty()) {
+        std::from_chars(arg.data(), arg.data() + arg.size(), samples);
+    }
+
+    const Entry entries[] = {
+#if FP_BENCH_CODE_SIZE
+        {"fp_result", result_pipeline, FP_BENCH_SECTION_SIZE(fpbench_result)},
+        {"fp_result_static_error", static_pipeline, FP_BENCH_SECTION_SIZE(fpbench_static)},
+        {"exceptions", throwing_pipeline, FP_BENCH_SECTION_SIZE(fpbench_exceptions)},
+#if FP_RESULT_HAS_EXPECTED
+        {"std_expected", expected_pipeline, FP_BENCH_SECTION_SIZE(fpbench_expected)},
+#endif
+#else
+        {"fp_result", result_pipeline, -1},
+        {"fp_result_static_error", static_pipeline, -1},
+        {"exceptions", throwing_pipeline, -1},
+#if FP_RESULT_HAS_EXPECTED
+        {"std_expected", expected_pipeline, -1},
+#endif
+#endif
+    };
+
+    std::string out = "{\"benchmark\":\"fp-cpp-init-bench-result\"," +
+                      fp::bench::environment_fields() + ",\"results\":[";
+    bool first = true;
+    for (const auto& entry : entries) {
+        auto success = run(entry.pipeline, kGood, samples);
+        auto error = run(entry.pipeline, kBad, samples);
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        out += "{\"name\":\"";
+        out += entry.name;
+        out += "\",\"code_size_bytes\":";
+        out += entry.code_size < 0 ? "null" : std::to_string(entry.code_size);
+        out += ",\"success\":{" + fp::bench::stats_fields(success) + "}";
+        out += ",\"error\":{" + fp::bench::stats_fields(error) + "}}";
+    }
+    out += "]}\n";
+    return fp::bench::emit(argc, argv, out);
+}
@@ -0,0 +1,141 @@
+// 进程启动延迟基准：用 posix_spawn 反复运行 fp-cpp-init，测量 spawn 到退出的耗时
+// 覆盖 --version、--help 与写入 tmpfs 的 new；包含动态加载、静态初始化与 git 子进程的开销
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "bench_util.hpp"
+
+extern char** environ;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 副作用：运行一次子进程（输出丢弃），返回耗时（ns）；失败返回负数
+auto spawn_once(const std::string& binary, const std::vector<std::string>& args) -> double {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(binary.c_str()));
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = 0;
+    int rc = posix_spawn(&pid, binary.c_str(), &actions, nullptr, argv.data(), environ);
+    int status = 0;
+    if (rc == 0) {
+        waitpid(pid, &status, 0);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (rc != 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return -1;
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+// 副作用：运行 runs 次，args_for(i) 给出第 i 次的参数
+template <typename ArgsFor>
+auto run_case(const std::string& binary, size_t runs, ArgsFor&& args_for)
+    -> fp::Result<fp::bench::Stats> {
+    constexpr size_t warmup = 5;
+    std::vector<double> samples;
+    samples.reserve(runs);
+    for (size_t i = 0; i < warmup + runs; ++i) {
+        double ns = spawn_once(binary, args_for(i));
+        if (ns < 0) {
+            return fp::Result<fp::bench::Stats>::err("run failed: " + binary);
+        }
+        if (i >= warmup) {
+            samples.push_back(ns);
+        }
+    }
+    return fp::Result<fp::bench::Stats>::ok(fp::bench::summarize(std::move(samples), 1));
+}
+
+// 副作用：new 的工作目录，优先使用 tmpfs
+auto scratch_root() -> fs::path {
+    std::error_code ec;
+    fs::path base =
+        fs::is_directory("/dev/shm", ec) ? fs::path("/dev/shm") : fs::temp_directory_path();
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    return base / ("fp-cpp-init-bench-startup-" + std::to_string(stamp));
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    size_t runs = 1000;
+    if (auto arg = fp::bench::arg_value(argc, argv, "--runs"); !arg.empty()) {
+        std::from_chars(arg.data(), arg.data() + arg.size(), runs);
+    }
+    auto binary_arg = fp::bench::arg_value(argc, argv, "--binary");
+    std::string binary = binary_arg.empty() ? FP_CPP_INIT_BINARY : std::string(binary_arg);
+    binary = fs::absolute(binary).string();
+
+    // new 在 scratch 目录下创建项目：子进程继承当前工作目录
+    // 结束后切回原目录，相对的 --output 路径仍相对于启动目录
+    auto start_dir = fs::current_path();
+    auto root = scratch_root();
+    fs::create_directories(root);
+    fs::current_path(root);
+
+    struct Case {
+        const char* name;
+        std::vector<std::string> (*args_for)(size_t);
+    };
+    const Case cases[] = {
+        {"--version", [](size_t) { return std::vector<std::string>{"--version"}; }},
+        {"--help", [](size_t) { return std::vector<std::string>{"--help"}; }},
+        {"new", [](size_t i) {
+             std::string name = "p";
+             name += std::to_string(i);
+             return std::vector<std::string>{"new", name, "--type=lib"};
+         }},
+    };
+
+    std::string results;
+    int exit_code = 0;
+    for (const auto& c : cases) {
+        auto stats = run_case(binary, runs, c.args_for);
+        if (stats.is_err()) {
+            std::fprintf(stderr, "%s: %s\n", c.name, stats.error().c_str());
+            exit_code = 1;
+            break;
+        }
+        if (!results.empty()) {
+            results += ',';
+        }
+        results += "{\"name\":" + fp::json::quote(c.name) + "," +
+                   fp::bench::stats_fields(stats.value()) + "}";
+    }
+
+    fs::current_path(start_dir);
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    if (exit_code != 0) {
+        return exit_code;
+    }
+
+    return fp::bench::emit(argc, argv,
+                           "{\"benchmark\":\"fp-cpp-init-bench-startup\"," +
+                               fp::bench::environment_fields() + ",\"binary\":" +
+                               fp::json::quote(binary) + ",\"results\":[" + results + "]}\n");
+}
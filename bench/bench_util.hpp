@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fp-cpp-init/json.hpp"
+
+namespace fp::bench {
+
+// 阻止编译器把被测结果优化掉
+template <typename T>
+inline auto do_not_optimize(const T& value) -> void {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// 纯数据：一组样本（每个样本为单次操作的纳秒数）的统计
+struct Stats {
+    double median_ns = 0;
+    double p90_ns = 0;
+    double p99_ns = 0;
+    double max_ns = 0;
+    double min_ns = 0;
+    double mean_ns = 0;
+    size_t samples = 0;
+    size_t iterations_per_sample = 0;
+};
+
+// 纯函数：由样本计算统计量（会对副本排序）
+inline auto summarize(std::vector<double> samples, size_t iterations_per_sample) -> Stats {
+    Stats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double q) {
+        auto idx = static_cast<size_t>(q * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(idx, samples.size() - 1)];
+    };
+    double sum = 0;
+    for (double s : samples) {
+        sum += s;
+    }
+    stats.median_ns = at(0.5);
+    stats.p90_ns = at(0.9);
+    stats.p99_ns = at(0.99);
+    stats.max_ns = samples.back();
+    stats.min_ns = samples.front();
+    stats.mean_ns = sum / static_cast<double>(samples.size());
+    stats.samples = samples.size();
+    stats.iterations_per_sample = iterations_per_sample;
+    return stats;
+}
+
+// 采样：每个样本连续运行 iterations 次 op，记录平均单次耗时
+// 小操作需要较大的 iterations 才能摊薄计时开销
+template <typename Op>
+auto measure(Op&& op, size_t samples, size_t iterations, size_t warmup = 3) -> Stats {
+    using Clock = std::chrono::steady_clock;
+
+    for (size_t i = 0; i < warmup * iterations; ++i) {
+        op();
+    }
+
+    std::vector<double> per_op;
+    per_op.reserve(samples);
+    for (size_t s = 0; s < samples; ++s) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            op();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        per_op.push_back(elapsed / static_cast<double>(iterations));
+    }
+    return summarize(std::move(per_op), iterations);
+}
+
+// 副作用：估算每个样本需要的迭代次数，使单个样本至少耗时 target_ns
+// 慢操作（如写盘）得到 1，单个样本即一次调用，p99 才有意义
+template <typename Op>
+auto calibrate(Op&& op, double target_ns = 20000) -> size_t {
+    using Clock = std::chrono::steady_clock;
+    size_t iterations = 1;
+    while (iterations < (size_t{1} << 20)) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            op();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (elapsed >= target_ns) {
+            break;
+        }
+        iterations *= 2;
+    }
+    return iterations;
+}
+
+// 纯函数：将统计量序列化为 JSON 字段（不含大括号）
+inline auto stats_fields(const Stats& stats) -> std::string {
+    char buf[256];
+    std::snprintf(buf, sizeof(buf),
+                  "\"median_ns\":%.3f,\"p90_ns\":%.3f,\"p99_ns\":%.3f,\"min_ns\":%.3f,"
+                  "\"max_ns\":%.3f,\"mean_ns\":%.3f,\"samples\":%zu,\"iterations_per_sample\":%zu",
+                  stats.median_ns, stats.p90_ns, stats.p99_ns, stats.min_ns, stats.max_ns,
+                  stats.mean_ns, stats.samples, stats.iterations_per_sample);
+    return buf;
+}
+
+// 纯函数：运行环境描述，便于比较不同机器/编译器的结果
+inline auto environment_fields() -> std::string {
+#if defined(__clang__)
+    std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    std::string compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    std::string compiler = "unknown";
+#endif
+#if defined(NDEBUG)
+    bool optimized = true;
+#else
+    bool optimized = false;
+#endif
+    return "\"compiler\":" + json::quote(compiler) +
+           ",\"cplusplus\":" + std::to_string(__cplusplus) +
+           ",\"ndebug\":" + (optimized ? "true" : "false");
+}
+
+// 解析 --name=value 形式的数值参数
+inline auto arg_value(int argc, char* argv[], std::string_view name) -> std::string_view {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.size() > name.size() && arg.substr(0, name.size()) == name &&
+            arg[name.size()] == '=') {
+            return arg.substr(name.size() + 1);
+        }
+    }
+    return {};
+}
+
+// 副作用：输出 JSON 到 --output=<file>，未指定时写到 stdout
+inline auto emit(int argc, char* argv[], const std::string& json_text) -> int {
+    auto output = arg_value(argc, argv, "--output");
+    if (output.empty()) {
+        std::fwrite(json_text.data(), 1, json_text.size(), stdout);
+        return 0;
+    }
+    std::string path(output);
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    std::fwrite(json_text.data(), 1, json_text.size(), file);
+    std::fclose(file);
+    return 0;
+}
+
+} // namespace fp::bench
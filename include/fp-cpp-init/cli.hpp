@@ -7,7 +7,7 @@
 namespace fp {
 
 // 命令类型
-enum class Command { Help, NewHelp, Version, New };
+enum class Command { Help, NewHelp, Version, New, Serve };
 
 // 不可变选项结构
 struct Options {
@@ -20,11 +20,24 @@ struct Options {
     std::string description;
     bool enable_ci = true;
     bool enable_lint = true;
+    bool enable_bench = false;
+    bool enable_pgo = false;
+    bool enable_lto = false;
+    bool enable_fast_build = false;
+    bool enable_profiling = false;
+    bool enable_alloc_tracking = false;
+    bool enable_perf_counters = false;
+    std::string trace_path;
+    std::string socket_path;
+    std::string root_path;
 };
 
 // 纯函数：解析命令行参数
 auto parse_args(int argc, char* argv[]) -> Result<Options>;
 
+// 纯函数：校验 type / license / std 取值（供非命令行入口复用）
+auto validate_options(const Options& opts) -> Result<Options>;
+
 // 纯函数：生成帮助文本
 auto get_help_text() -> std::string;
 auto get_new_help_text() -> std::string;
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <string_view>
+
+#include "fp-cpp-init/result.hpp"
+
+namespace fp::cli {
+
+// 选项标识：parse_args 据此写入 Options 的对应字段
+enum class OptionId {
+    Type,
+    License,
+    Std,
+    Author,
+    Desc,
+    Trace,
+    NoCi,
+    NoLint,
+    Bench,
+    Pgo,
+    Lto,
+    FastBuild,
+    Profiling,
+    AllocTracking,
+    PerfCounters,
+    Socket,
+    Root,
+};
+
+// Value: --opt=value 或 --opt value；Flag: 无参数开关
+enum class OptionKind { Value, Flag };
+
+// 纯数据：一条选项的完整描述（解析、校验、帮助文本共用）
+struct OptionSpec {
+    OptionId id;
+    OptionKind kind;
+    std::string_view long_name;
+    std::string_view short_name; // 空表示无短选项
+    std::string_view metavar;    // 帮助文本中的 <METAVAR>
+    std::string_view help;
+    std::string_view values; // 逗号分隔的合法取值，空表示不限制
+    std::string_view label;  // 错误消息中的名称
+};
+
+// 纯函数：value 是否为逗号分隔列表 values 中的一项（values 为空时总是合法）
+constexpr auto is_one_of(std::string_view values, std::string_view value) -> bool {
+    if (values.empty()) {
+        return true;
+    }
+    while (!values.empty()) {
+        auto comma = values.find(", ");
+        if (values.substr(0, comma) == value) {
+            return true;
+        }
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        values.remove_prefix(comma + 2);
+    }
+    return false;
+}
+
+// new 命令的选项表（顺序即帮助文本中的顺序）
+inline constexpr std::array new_options{
+    OptionSpec{OptionId::Type, OptionKind::Value, "--type", "-t", "TYPE",
+               "Project type [default: exe]", "exe, lib, header", "type"},
+    OptionSpec{OptionId::License, OptionKind::Value, "--license", "-l", "LICENSE",
+               "License type [default: mit]", "mit, apache2, gpl3, bsd3, none", "license"},
+    OptionSpec{OptionId::Std, OptionKind::Value, "--std", "-s", "STANDARD",
+               "C++ standard [default: 20]", "17, 20, 23", "C++ standard"},
+    OptionSpec{OptionId::Author, OptionKind::Value, "--author", "-a", "NAME",
+               "Author name [default: git config user.name]", "", "author"},
+    OptionSpec{OptionId::Desc, OptionKind::Value, "--desc", "-d", "TEXT", "Project description",
+               "", "description"},
+    OptionSpec{OptionId::Trace, OptionKind::Value, "--trace", "", "FILE",
+               "Write a Chrome trace-event file of the run", "", "trace file"},
+    OptionSpec{OptionId::NoCi, OptionKind::Flag, "--no-ci", "", "",
+               "Disable GitHub Actions CI/CD", "", ""},
+    OptionSpec{OptionId::NoLint, OptionKind::Flag, "--no-lint", "", "",
+               "Disable .clang-format and .clang-tidy", "", ""},
+    OptionSpec{OptionId::Bench, OptionKind::Flag, "--bench", "", "",
+               "Generate bench/ with a microbenchmark harness", "", ""},
+    OptionSpec{OptionId::Pgo, OptionKind::Flag, "--pgo", "", "",
+               "Add a profile-guided optimization workflow (PGO_MODE)", "", ""},
+    OptionSpec{OptionId::Lto, OptionKind::Flag, "--lto", "", "",
+               "Enable link-time optimization for Release builds", "", ""},
+    OptionSpec{OptionId::FastBuild, OptionKind::Flag, "--fast-build", "", "",
+               "Enable unity builds and precompiled headers", "", ""},
+    OptionSpec{OptionId::Profiling, OptionKind::Flag, "--profiling", "", "",
+               "Add perf/cachegrind/heaptrack profiling targets (Linux)", "", ""},
+    OptionSpec{OptionId::AllocTracking, OptionKind::Flag, "--alloc-tracking", "", "",
+               "Add per-thread heap allocation counters (TRACK_ALLOCATIONS)", "", ""},
+    OptionSpec{OptionId::PerfCounters, OptionKind::Flag, "--perf-counters", "", "",
+               "Add Linux hardware performance counters (perf_event_open)", "", ""},
+};
+
+// serve 命令的选项表
+inline constexpr std::array serve_options{
+    OptionSpec{OptionId::Socket, OptionKind::Value, "--socket", "", "PATH",
+               "Unix domain socket to listen on", "", "socket path"},
+    OptionSpec{OptionId::Root, OptionKind::Value, "--root", "", "DIR",
+               "Directory that request dirs resolve under [default: .]", "", "root directory"},
+};
+
+// 纯函数：按长/短选项名查找（name 不含 =value 部分）
+constexpr auto find_option(std::span<const OptionSpec> table, std::string_view name)
+    -> const OptionSpec* {
+    for (const auto& spec : table) {
+        if (name == spec.long_name || (!spec.short_name.empty() && name == spec.short_name)) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+// 校验结果：成功时原样返回取值；错误为静态消息，可在编译期求值
+using ValueCheck = Result<std::string_view, StaticError>;
+
+// 纯函数：按标识查找选项
+constexpr auto find_option(std::span<const OptionSpec> table, OptionId id) -> const OptionSpec* {
+    for (const auto& spec : table) {
+        if (spec.id == id) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+// 纯函数：value 是否为 spec 允许的取值
+constexpr auto check_value(const OptionSpec& spec, std::string_view value) -> ValueCheck {
+    if (!is_one_of(spec.values, value)) {
+        return ValueCheck::err(StaticError{"Value is not allowed"});
+    }
+    return ValueCheck::ok(value);
+}
+
+// 纯函数：按选项表校验某个选项的取值
+constexpr auto validate_value(std::span<const OptionSpec> table, OptionId id,
+                              std::string_view value) -> ValueCheck {
+    const auto* spec = find_option(table, id);
+    if (spec == nullptr) {
+        return ValueCheck::err(StaticError{"Unknown option"});
+    }
+    return check_value(*spec, value);
+}
+
+// 常用选项的便捷校验
+constexpr auto validate_type(std::string_view value) -> ValueCheck {
+    return validate_value(new_options, OptionId::Type, value);
+}
+
+constexpr auto validate_license(std::string_view value) -> ValueCheck {
+    return validate_value(new_options, OptionId::License, value);
+}
+
+constexpr auto validate_std(std::string_view value) -> ValueCheck {
+    return validate_value(new_options, OptionId::Std, value);
+}
+
+} // namespace fp::cli
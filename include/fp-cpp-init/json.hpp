@@ -0,0 +1,25 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "fp-cpp-init/result.hpp"
+
+namespace fp::json {
+
+// 单层 JSON 对象：值为字符串（数字按原文保存）或布尔
+using Value = std::variant<std::string, bool>;
+using FlatObject = std::map<std::string, Value, std::less<>>;
+
+// 纯函数：追加 JSON 字符串转义后的内容（不含引号）
+auto append_escaped(std::string& out, std::string_view s) -> void;
+
+// 纯函数：转义并加上引号
+auto quote(std::string_view s) -> std::string;
+
+// 纯函数：解析单层 JSON 对象（不支持嵌套对象、数组和 null）
+auto parse_flat_object(std::string_view text) -> Result<FlatObject>;
+
+} // namespace fp::json
@@ -21,6 +21,9 @@ struct ProjectFiles {
     std::vector<FileEntry> files;
 };
 
+// 纯函数：根据选项构建渲染上下文
+auto make_render_context(const Options& opts, std::string year) -> RenderContext;
+
 // 纯函数：根据选项生成项目结构（不执行任何 IO）
 auto generate_project(const Options& opts, const RenderContext& ctx) -> ProjectFiles;
 
@@ -1,47 +1,304 @@
 #pragma once
 
+#include <cstddef>
+#include <cstring>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <version>
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#include <expected>
+#define FP_RESULT_HAS_EXPECTED 1
+#else
+#define FP_RESULT_HAS_EXPECTED 0
+#endif
 
 namespace fp {
 
-// Result 类型：成功值或错误消息
-template <typename T>
+class StaticError;
+
+namespace literals {
+consteval auto operator""_err(const char* msg, std::size_t len) -> StaticError;
+} // namespace literals
+
+// 静态错误消息：只保存指向字符串字面量的指针，构造和复制都不分配内存
+// 适合热路径上固定文案的错误，也可用于常量求值
+class StaticError {
+  public:
+    // consteval：只接受字符串字面量等静态存储期的字符数组，运行期的指针无法传入
+    template <std::size_t N>
+    consteval StaticError(const char (&msg)[N]) noexcept : msg_(msg) {}
+
+    constexpr auto message() const noexcept -> std::string_view { return msg_; }
+
+    constexpr auto c_str() const noexcept -> const char* { return msg_; }
+
+    friend constexpr auto operator==(StaticError a, StaticError b) noexcept -> bool {
+        return a.message() == b.message();
+    }
+
+  private:
+    struct FromLiteral {};
+
+    // 仅供 _err 使用：带标签，避免与数组构造函数竞争重载
+    constexpr StaticError(FromLiteral /*tag*/, const char* msg) noexcept : msg_(msg) {}
+
+    friend consteval auto literals::operator""_err(const char* msg, std::size_t len)
+        -> StaticError;
+
+    const char* msg_;
+};
+
+namespace literals {
+
+// "..."_err：只接受字符串字面量，保证消息具有静态存储期
+consteval auto operator""_err(const char* msg, std::size_t /*len*/) -> StaticError {
+    return StaticError{StaticError::FromLiteral{}, msg};
+}
+
+} // namespace literals
+
+namespace detail {
+
+// 堆上保存的错误：成功时只占一个空指针
+template <typename E>
+class BoxedError {
+  public:
+    constexpr BoxedError() noexcept = default;
+
+    constexpr explicit BoxedError(E error) : ptr_(new E(std::move(error))) {}
+
+    constexpr BoxedError(const BoxedError& other)
+        : ptr_(other.ptr_ ? new E(*other.ptr_) : nullptr) {}
+
+    constexpr BoxedError(BoxedError&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+
+    constexpr auto operator=(BoxedError other) noexcept -> BoxedError& {
+        std::swap(ptr_, other.ptr_);
+        return *this;
+    }
+
+    constexpr ~BoxedError() { delete ptr_; }
+
+    constexpr auto has_error() const noexcept -> bool { return ptr_ != nullptr; }
+
+    constexpr auto get() const noexcept -> const E& { return *ptr_; }
+
+    constexpr auto take() noexcept -> E&& { return std::move(*ptr_); }
+
+  private:
+    E* ptr_ = nullptr;
+};
+
+// 堆上保存的字符串错误：长度与字符放在同一块内存里，构造只分配一次
+// 布局：[std::size_t 长度][字符]，成功时只占一个空指针
+class BoxedMessage {
+  public:
+    BoxedMessage() noexcept = default;
+
+    explicit BoxedMessage(std::string_view message)
+        : data_(new char[sizeof(std::size_t) + message.size()]) {
+        std::size_t size = message.size();
+        std::memcpy(data_, &size, sizeof(size));
+        // 空的 string_view 的 data() 可能为空指针，不能传给 memcpy
+        if (size > 0) {
+            std::memcpy(data_ + sizeof(size), message.data(), size);
+        }
+    }
+
+    BoxedMessage(const BoxedMessage& other)
+        : BoxedMessage(other.data_ ? BoxedMessage(other.get()) : BoxedMessage()) {}
+
+    BoxedMessage(BoxedMessage&& other) noexcept : data_(std::exchange(other.data_, nullptr)) {}
+
+    auto operator=(BoxedMessage other) noexcept -> BoxedMessage& {
+        std::swap(data_, other.data_);
+        return *this;
+    }
+
+    ~BoxedMessage() { delete[] data_; }
+
+    auto has_error() const noexcept -> bool { return data_ != nullptr; }
+
+    auto get() const noexcept -> std::string_view {
+        std::size_t size = 0;
+        std::memcpy(&size, data_, sizeof(size));
+        return {data_ + sizeof(size), size};
+    }
+
+    auto take() const -> std::string { return std::string(get()); }
+
+  private:
+    char* data_ = nullptr;
+};
+
+// 内联保存的错误：用于枚举、错误码、StaticError 等小而平凡的类型
+template <typename E>
+class InlineError {
+  public:
+    constexpr InlineError() noexcept = default;
+
+    constexpr explicit InlineError(E error) noexcept : error_(error) {}
+
+    constexpr auto has_error() const noexcept -> bool { return error_.has_value(); }
+
+    constexpr auto get() const noexcept -> const E& { return *error_; }
+
+    constexpr auto take() noexcept -> E&& { return std::move(*error_); }
+
+  private:
+    std::optional<E> error_;
+};
+
+template <typename E>
+using VoidErrorSlot = std::conditional_t<
+    std::is_same_v<E, std::string>,
+    BoxedMessage,
+    std::conditional_t<std::is_trivially_copyable_v<E> && sizeof(E) <= sizeof(void*),
+                       InlineError<E>,
+                       BoxedError<E>>>;
+
+// variant 后端：C++20 下的默认实现
+template <typename T, typename E>
+class VariantStorage {
+  public:
+    constexpr explicit VariantStorage(std::in_place_index_t<0> tag, T value)
+        : data_(tag, std::move(value)) {}
+    constexpr explicit VariantStorage(std::in_place_index_t<1> tag, E error)
+        : data_(tag, std::move(error)) {}
+
+    constexpr auto has_value() const noexcept -> bool { return data_.index() == 0; }
+
+    constexpr auto value() const& -> const T& { return std::get<0>(data_); }
+    constexpr auto value() && -> T&& { return std::get<0>(std::move(data_)); }
+
+    constexpr auto error() const& -> const E& { return std::get<1>(data_); }
+    constexpr auto error() && -> E&& { return std::get<1>(std::move(data_)); }
+
+  private:
+    // 按下标区分，T 与 E 相同（如 Result<std::string>）时仍无歧义
+    std::variant<T, E> data_;
+};
+
+struct VariantBackend {
+    template <typename T, typename E>
+    using storage = VariantStorage<T, E>;
+};
+
+#if FP_RESULT_HAS_EXPECTED
+
+// std::expected 后端：以 C++23 编译时的默认实现
+template <typename T, typename E>
+class ExpectedStorage {
+  public:
+    constexpr explicit ExpectedStorage(std::in_place_index_t<0> /*tag*/, T value)
+        : data_(std::in_place, std::move(value)) {}
+    constexpr explicit ExpectedStorage(std::in_place_index_t<1> /*tag*/, E error)
+        : data_(std::unexpect, std::move(error)) {}
+
+    constexpr auto has_value() const noexcept -> bool { return data_.has_value(); }
+
+    constexpr auto value() const& -> const T& { return data_.value(); }
+    constexpr auto value() && -> T&& { return std::move(data_).value(); }
+
+    constexpr auto error() const& -> const E& { return data_.error(); }
+    constexpr auto error() && -> E&& { return std::move(data_).error(); }
+
+  private:
+    std::expected<T, E> data_;
+};
+
+struct ExpectedBackend {
+    template <typename T, typename E>
+    using storage = ExpectedStorage<T, E>;
+};
+
+#endif
+
+// 定义 FP_RESULT_USE_VARIANT 可在 C++23 下强制使用 variant 后端
+#if FP_RESULT_HAS_EXPECTED && !defined(FP_RESULT_USE_VARIANT)
+using DefaultBackend = ExpectedBackend;
+#else
+using DefaultBackend = VariantBackend;
+#endif
+
+} // namespace detail
+
+// Result 类型：成功值或错误（默认错误类型为 std::string）
+// Backend 决定存储方式：C++23 下为 std::expected，否则为 std::variant
+// 所有成员均为 constexpr：T、E 为字面类型（如 StaticError）时可在编译期求值
+template <typename T, typename E = std::string, typename Backend = detail::DefaultBackend>
 class Result {
   public:
+    using value_type = T;
+    using error_type = E;
+    using backend_type = Backend;
+
     // 构造成功结果
-    static auto ok(T value) -> Result { return Result{std::move(value)}; }
+    static constexpr auto ok(T value) -> Result {
+        return Result{std::in_place_index<0>, std::move(value)};
+    }
 
     // 构造错误结果
-    static auto err(std::string error) -> Result { return Result{Error{std::move(error)}}; }
+    static constexpr auto err(E error) -> Result {
+        return Result{std::in_place_index<1>, std::move(error)};
+    }
+
+    // 接收 Result<void> 的 std::string_view 错误；字面量走 const char* 以免重载歧义
+    static constexpr auto err(std::string_view message) -> Result
+        requires std::is_same_v<E, std::string>
+    {
+        return err(E(message));
+    }
+
+    static constexpr auto err(const char* message) -> Result
+        requires std::is_same_v<E, std::string>
+    {
+        return err(E(message));
+    }
 
     // 检查是否成功
-    auto is_ok() const -> bool { return std::holds_alternative<T>(data_); }
+    constexpr auto is_ok() const -> bool { return data_.has_value(); }
 
-    auto is_err() const -> bool { return std::holds_alternative<Error>(data_); }
+    constexpr auto is_err() const -> bool { return !data_.has_value(); }
 
     // 获取值（假定成功）
-    auto value() const& -> const T& { return std::get<T>(data_); }
+    constexpr auto value() const& -> const T& { return data_.value(); }
+
+    constexpr auto value() && -> T { return std::move(data_).value(); }
 
-    auto value() && -> T { return std::get<T>(std::move(data_)); }
+    // 获取错误（假定失败）
+    constexpr auto error() const& -> const E& { return data_.error(); }
 
-    // 获取错误消息（假定失败）
-    auto error() const -> const std::string& { return std::get<Error>(data_).msg; }
+    constexpr auto error() && -> E { return std::move(data_).error(); }
 
-    // map: 转换成功值
+    // map: 转换成功值（左值：复制出值与错误）
     template <typename F>
-    auto map(F&& f) const -> Result<decltype(f(std::declval<T>()))> {
-        using U = decltype(f(std::declval<T>()));
+    constexpr auto map(F&& f) const& -> Result<decltype(f(std::declval<T>())), E, Backend> {
+        using U = Result<decltype(f(std::declval<T>())), E, Backend>;
+        if (is_ok()) {
+            return U::ok(f(value()));
+        }
+        return U::err(error());
+    }
+
+    // map: 右值版本，值移入 f，错误直接移出
+    template <typename F>
+    constexpr auto map(F&& f) && -> Result<decltype(f(std::declval<T>())), E, Backend> {
+        using U = Result<decltype(f(std::declval<T>())), E, Backend>;
         if (is_ok()) {
-            return Result<U>::ok(f(value()));
+            return U::ok(f(std::move(data_).value()));
         }
-        return Result<U>::err(error());
+        return U::err(std::move(data_).error());
     }
 
     // and_then: 链式调用（返回 Result 的函数）
     template <typename F>
-    auto and_then(F&& f) const -> decltype(f(std::declval<T>())) {
+    constexpr auto and_then(F&& f) const& -> decltype(f(std::declval<T>())) {
         if (is_ok()) {
             return f(value());
         }
@@ -49,45 +306,121 @@ class Result {
         return U::err(error());
     }
 
+    // and_then: 右值版本，值移入 f，错误直接移出
+    template <typename F>
+    constexpr auto and_then(F&& f) && -> decltype(f(std::declval<T>())) {
+        if (is_ok()) {
+            return f(std::move(data_).value());
+        }
+        using U = decltype(f(std::declval<T>()));
+        return U::err(std::move(data_).error());
+    }
+
     // 获取值或默认值
-    auto value_or(T default_value) const -> T {
+    constexpr auto value_or(T default_value) const& -> T {
         if (is_ok()) {
             return value();
         }
         return default_value;
     }
 
-  private:
-    struct Error {
-        std::string msg;
-    };
+    constexpr auto value_or(T default_value) && -> T {
+        if (is_ok()) {
+            return std::move(data_).value();
+        }
+        return default_value;
+    }
 
-    std::variant<T, Error> data_;
+  private:
+    typename Backend::template storage<T, E> data_;
 
-    explicit Result(T value) : data_(std::move(value)) {}
-    explicit Result(Error error) : data_(std::move(error)) {}
+    template <std::size_t I, typename Arg>
+    constexpr explicit Result(std::in_place_index_t<I> tag, Arg&& arg)
+        : data_(tag, std::forward<Arg>(arg)) {}
 };
 
-// void 特化
-template <>
-class Result<void> {
+// void 特化：成功路径不携带任何错误存储（与后端无关）
+template <typename E, typename Backend>
+class Result<void, E, Backend> {
   public:
-    static auto ok() -> Result { return Result{true}; }
+    using value_type = void;
+    using error_type = E;
+    using backend_type = Backend;
+
+    static constexpr auto ok() -> Result { return Result{}; }
+
+    static constexpr auto err(E error) -> Result
+        requires(!std::is_same_v<E, std::string>)
+    {
+        return Result{std::move(error)};
+    }
+
+    // std::string 错误直接拷进一次分配的 BoxedMessage，不经过临时 std::string
+    static auto err(std::string_view message) -> Result
+        requires std::is_same_v<E, std::string>
+    {
+        Result result;
+        result.error_ = detail::BoxedMessage(message);
+        return result;
+    }
 
-    static auto err(std::string error) -> Result { return Result{std::move(error)}; }
+    static auto err(const char* message) -> Result
+        requires std::is_same_v<E, std::string>
+    {
+        return err(std::string_view(message));
+    }
 
-    auto is_ok() const -> bool { return success_; }
+    constexpr auto is_ok() const -> bool { return !error_.has_error(); }
 
-    auto is_err() const -> bool { return !success_; }
+    constexpr auto is_err() const -> bool { return error_.has_error(); }
 
-    auto error() const -> const std::string& { return error_; }
+    // 获取错误（假定失败）；E 为 std::string 时返回指向错误存储的 std::string_view
+    constexpr auto error() const -> decltype(auto) { return error_.get(); }
+
+    // map: 成功时调用无参函数 f
+    template <typename F>
+    constexpr auto map(F&& f) const& -> Result<decltype(f()), E, Backend> {
+        using U = decltype(f());
+        if (is_err()) {
+            return Result<U, E, Backend>::err(error());
+        }
+        if constexpr (std::is_void_v<U>) {
+            f();
+            return Result<U, E, Backend>::ok();
+        } else {
+            return Result<U, E, Backend>::ok(f());
+        }
+    }
+
+    // and_then: 成功时调用返回 Result 的无参函数 f
+    template <typename F>
+    constexpr auto and_then(F&& f) const& -> decltype(f()) {
+        if (is_ok()) {
+            return f();
+        }
+        return decltype(f())::err(error());
+    }
+
+    template <typename F>
+    constexpr auto and_then(F&& f) && -> decltype(f()) {
+        if (is_ok()) {
+            return f();
+        }
+        return decltype(f())::err(error_.take());
+    }
 
   private:
-    bool success_;
-    std::string error_;
+    detail::VoidErrorSlot<E> error_;
 
-    explicit Result(bool success) : success_(success) {}
-    explicit Result(std::string error) : success_(false), error_(std::move(error)) {}
+    constexpr Result() = default;
+    constexpr explicit Result(E error) : error_(std::move(error)) {}
 };
 
+// 常见实例的布局约束
+static_assert(sizeof(StaticError) == sizeof(const char*));
+static_assert(sizeof(Result<void>) == sizeof(void*), "Result<void> must stay pointer-sized");
+static_assert(sizeof(Result<void, StaticError>) <= 2 * sizeof(void*));
+static_assert(sizeof(Result<int, StaticError>) <= 2 * sizeof(void*));
+static_assert(sizeof(Result<void, int>) <= sizeof(void*));
+
 } // namespace fp
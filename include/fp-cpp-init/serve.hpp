@@ -0,0 +1,40 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "fp-cpp-init/cli.hpp"
+#include "fp-cpp-init/result.hpp"
+
+namespace fp::serve {
+
+// 常驻进程启动时解析一次的默认值（避免每个请求都调用 git）
+struct Defaults {
+    std::string author;
+    std::string year;
+    std::filesystem::path root; // 请求的 dir 只能落在此目录之下（已规范化）
+};
+
+// 纯数据：一条生成请求
+struct Request {
+    Options opts;
+    std::filesystem::path dir;
+};
+
+// 纯函数：解析一行 JSON 请求
+// {"name": "app", "type": "lib", "license": "mit", "std": "20", "author": "...",
+//  "desc": "...", "ci": true, "lint": true, "dir": "output/parent"}
+// dir 为相对 defaults.root 的路径：拒绝绝对路径与 ".."，解析符号链接后仍须位于 root 之下
+auto parse_request(std::string_view line, const Defaults& defaults) -> Result<Request>;
+
+// 处理一行请求并返回一行 JSON 响应（副作用：写入项目文件）
+// 成功：{"ok":true,"files":[...]}  失败：{"ok":false,"error":"..."}
+auto handle_request(std::string_view line, const Defaults& defaults) -> std::string;
+
+// 副作用：监听 Unix domain socket，由固定大小的线程池并发处理连接，直到 SIGINT/SIGTERM
+// 空闲连接超时关闭；等待队列满时直接回复繁忙；退出前 join 所有工作线程并恢复原信号处理
+// 所有请求的输出目录都限制在 root_path（空表示工作目录）之下
+auto run(const std::string& socket_path, const std::string& root_path) -> Result<void>;
+
+} // namespace fp::serve
@@ -37,14 +37,25 @@ else()
     add_compile_options(-Wall -Wextra -Wpedantic -Werror=return-type)
 endif()
 
-if(NOT CMAKE_BUILD_TYPE)
+if(NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
     set(CMAKE_BUILD_TYPE Debug)
 endif()
 
-if(CMAKE_BUILD_TYPE STREQUAL "Debug" AND NOT MSVC)
-    add_compile_options(-g -O0)
-elseif(NOT MSVC)
-    add_compile_options(-O3 -DNDEBUG)
+# Performance options (the presets in CMakePresets.json set these;
+# optimization levels come from CMAKE_BUILD_TYPE)
+option(ENABLE_FRAME_POINTERS "Keep frame pointers for profilers" OFF)
+option(ENABLE_NATIVE_ARCH "Optimize for the host CPU with -march=native" OFF)
+if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    if(ENABLE_FRAME_POINTERS)
+        add_compile_options(-fno-omit-frame-pointer)
+    endif()
+    if(ENABLE_NATIVE_ARCH)
+        include(CheckCXXCompilerFlag)
+        check_cxx_compiler_flag(-march=native HAS_MARCH_NATIVE)
+        if(HAS_MARCH_NATIVE)
+            add_compile_options(-march=native)
+        endif()
+    endif()
 endif()
 
 file(GLOB_RECURSE SOURCES "src/*.cpp")
@@ -91,10 +102,27 @@ else()
     add_compile_options(-Wall -Wextra -Wpedantic -Werror=return-type)
 endif()
 
-if(NOT CMAKE_BUILD_TYPE)
+if(NOT CMAKE_BUILD_TYPE AND NOT CMAKE_CONFIGURATION_TYPES)
     set(CMAKE_BUILD_TYPE Debug)
 endif()
 
+# Performance options (the presets in CMakePresets.json set these;
+# optimization levels come from CMAKE_BUILD_TYPE)
+option(ENABLE_FRAME_POINTERS "Keep frame pointers for profilers" OFF)
+option(ENABLE_NATIVE_ARCH "Optimize for the host CPU with -march=native" OFF)
+if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    if(ENABLE_FRAME_POINTERS)
+        add_compile_options(-fno-omit-frame-pointer)
+    endif()
+    if(ENABLE_NATIVE_ARCH)
+        include(CheckCXXCompilerFlag)
+        check_cxx_compiler_flag(-march=native HAS_MARCH_NATIVE)
+        if(HAS_MARCH_NATIVE)
+            add_compile_options(-march=native)
+        endif()
+    endif()
+endif()
+
 file(GLOB_RECURSE SOURCES "src/*.cpp")
 add_library(${PROJECT_NAME} STATIC ${SOURCES})
 
@@ -146,6 +174,23 @@ else()
     add_compile_options(-Wall -Wextra -Wpedantic -Werror=return-type)
 endif()
 
+# Performance options (the presets in CMakePresets.json set these;
+# optimization levels come from CMAKE_BUILD_TYPE)
+option(ENABLE_FRAME_POINTERS "Keep frame pointers for profilers" OFF)
+option(ENABLE_NATIVE_ARCH "Optimize for the host CPU with -march=native" OFF)
+if(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    if(ENABLE_FRAME_POINTERS)
+        add_compile_options(-fno-omit-frame-pointer)
+    endif()
+    if(ENABLE_NATIVE_ARCH)
+        include(CheckCXXCompilerFlag)
+        check_cxx_compiler_flag(-march=native HAS_MARCH_NATIVE)
+        if(HAS_MARCH_NATIVE)
+            add_compile_options(-march=native)
+        endif()
+    endif()
+endif()
+
 # Header-only library
 add_library(${PROJECT_NAME} INTERFACE)
 
@@ -168,21 +213,152 @@ endif()
 install(DIRECTORY include/ DESTINATION include)
 )";
 
+// Inserted near the top of every CMakeLists.txt (before any target): compiler cache and
+// fast linker detection for the edit-compile-link loop
+constexpr const char* cmake_dev_tools = R"(
+# Developer loop: compiler cache and fast linker, each picked when installed
+option(ENABLE_COMPILER_CACHE "Use ccache or sccache as compiler launcher" ON)
+option(ENABLE_FAST_LINKER "Link with mold or lld" ON)
+
+if(ENABLE_COMPILER_CACHE AND NOT CMAKE_CXX_COMPILER_LAUNCHER)
+    find_program(COMPILER_CACHE_PROGRAM NAMES ccache sccache)
+    if(COMPILER_CACHE_PROGRAM)
+        set(CMAKE_CXX_COMPILER_LAUNCHER ${COMPILER_CACHE_PROGRAM})
+        message(STATUS "Compiler cache: ${COMPILER_CACHE_PROGRAM}")
+    else()
+        message(STATUS "Compiler cache: none, install ccache or sccache to enable")
+    endif()
+endif()
+
+if(ENABLE_FAST_LINKER AND NOT CMAKE_LINKER_TYPE AND CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    # lld cannot link GCC's LTO objects, so GCC only tries mold
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        set(fast_linker_candidates mold)
+    else()
+        set(fast_linker_candidates mold lld)
+    endif()
+
+    include(CheckLinkerFlag)
+    set(FAST_LINKER "")
+    foreach(candidate ${fast_linker_candidates})
+        check_linker_flag(CXX "-fuse-ld=${candidate}" HAS_LINKER_${candidate})
+        if(HAS_LINKER_${candidate})
+            set(FAST_LINKER ${candidate})
+            break()
+        endif()
+    endforeach()
+
+    if(FAST_LINKER)
+        if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.29)
+            string(TOUPPER ${FAST_LINKER} linker_type)
+            set(CMAKE_LINKER_TYPE ${linker_type})
+        else()
+            add_link_options(-fuse-ld=${FAST_LINKER})
+        endif()
+        message(STATUS "Linker: ${FAST_LINKER}")
+    else()
+        message(STATUS "Linker: default, install mold or lld for faster links")
+    endif()
+endif()
+)";
+
+// CMakePresets.json: named build profiles (schema v3, CMake 3.21+).
+// No generator is pinned: CMake's default or $CMAKE_GENERATOR is used.
+constexpr const char* cmake_presets = R"({
+  "version": 3,
+  "cmakeMinimumRequired": {
+    "major": 3,
+    "minor": 21,
+    "patch": 0
+  },
+  "configurePresets": [
+    {
+      "name": "base",
+      "hidden": true,
+      "binaryDir": "${sourceDir}/build/${presetName}"
+    },
+    {
+      "name": "debug",
+      "displayName": "Debug",
+      "inherits": "base",
+      "cacheVariables": {
+        "CMAKE_BUILD_TYPE": "Debug"
+      }
+    },
+    {
+      "name": "release",
+      "displayName": "Release",
+      "inherits": "base",
+      "cacheVariables": {
+        "CMAKE_BUILD_TYPE": "Release"
+      }
+    },
+    {
+      "name": "relwithdebinfo-perf",
+      "displayName": "Profiling: -O2 -g with frame pointers",
+      "inherits": "base",
+      "cacheVariables": {
+        "CMAKE_BUILD_TYPE": "RelWithDebInfo",
+        "ENABLE_FRAME_POINTERS": "ON"
+      }
+    },
+    {
+      "name": "release-native",
+      "displayName": "Release tuned for the host CPU with -march=native",
+      "inherits": "release",
+      "cacheVariables": {
+        "ENABLE_NATIVE_ARCH": "ON"
+      }
+    },
+    {
+      "name": "release-lto",
+      "displayName": "Release with link-time optimization",
+      "inherits": "release",
+      "cacheVariables": {
+        "CMAKE_INTERPROCEDURAL_OPTIMIZATION": "ON"
+      }
+    }
+  ],
+  "buildPresets": [
+    { "name": "debug", "configurePreset": "debug" },
+    { "name": "release", "configurePreset": "release" },
+    { "name": "relwithdebinfo-perf", "configurePreset": "relwithdebinfo-perf" },
+    { "name": "release-native", "configurePreset": "release-native" },
+    { "name": "release-lto", "configurePreset": "release-lto" }
+  ],
+  "testPresets": [
+    {
+      "name": "debug",
+      "configurePreset": "debug",
+      "output": { "outputOnFailure": true }
+    },
+    {
+      "name": "release",
+      "configurePreset": "release",
+      "output": { "outputOnFailure": true }
+    }
+  ]
+}
+)";
+
 constexpr const char* cmake_examples = R"(add_executable(example example.cpp)
 target_link_libraries(example PRIVATE {{PROJECT_NAME}})
 )";
 
-constexpr const char* cmake_tests = R"(# Tests using simple assertions
-# For a proper test framework, consider Catch2:
-# include(FetchContent)
-# FetchContent_Declare(Catch2 GIT_REPOSITORY https://github.com/catchorg/Catch2.git GIT_TAG v3.5.2)
-# FetchContent_MakeAvailable(Catch2)
-
+constexpr const char* cmake_tests = R"(# Tests use the always-on CHECK harness in test.hpp, so Release builds
+# (-DNDEBUG) are tested too
 add_executable(tests test_main.cpp)
 target_link_libraries(tests PRIVATE {{PROJECT_NAME}})
 
-# CTest integration
-add_test(NAME {{PROJECT_NAME}}_tests COMMAND tests)
+# Register every TEST_CASE with CTest as its own test, so `ctest -j N` runs
+# them in parallel and reports each one's time; CMake re-reads the list
+# whenever test_main.cpp changes
+set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS test_main.cpp)
+file(STRINGS test_main.cpp test_case_lines REGEX "^TEST_CASE\\(")
+foreach(line IN LISTS test_case_lines)
+    string(REGEX REPLACE "^TEST_CASE\\(([A-Za-z0-9_]+)\\).*" "\\1" test_name "${line}")
+    add_test(NAME {{PROJECT_NAME}}.${test_name} COMMAND tests ${test_name})
+endforeach()
 )";
 
 // =============================================================================
@@ -390,6 +566,52 @@ auto parse_int(std::string_view input) -> Result<int> {
 } // namespace {{PROJECT_NAME_ID}}
 )";
 
+// Replaces the add_executable() lines of cmake_exe when --bench is given
+constexpr const char* cmake_exe_core = R"(# Everything in src/ except main.cpp forms {{PROJECT_NAME_ID}}_core, which the
+# application and the benchmarks both link
+file(GLOB_RECURSE SOURCES "src/*.cpp")
+list(REMOVE_ITEM SOURCES ${CMAKE_SOURCE_DIR}/src/main.cpp)
+add_library({{PROJECT_NAME_ID}}_core STATIC ${SOURCES})
+target_include_directories({{PROJECT_NAME_ID}}_core PUBLIC ${CMAKE_SOURCE_DIR}/include)
+
+add_executable(${PROJECT_NAME} src/main.cpp)
+target_link_libraries(${PROJECT_NAME} PRIVATE {{PROJECT_NAME_ID}}_core)
+)";
+
+// src/main.cpp when the functions live in src/<name>.cpp (--bench)
+constexpr const char* main_core_cpp = R"(#include <iostream>
+
+#include "{{PROJECT_NAME}}/{{PROJECT_NAME}}.hpp"
+
+// =============================================================================
+// Main - Side Effect Boundary (all IO happens here)
+// The pure functions are in src/{{PROJECT_NAME}}.cpp
+// =============================================================================
+
+int main() {
+    // Call pure functions
+    auto message = {{PROJECT_NAME_ID}}::greet("{{PROJECT_NAME}}");
+    std::cout << message << std::endl;
+
+    // Demonstrate pure arithmetic
+    std::cout << "2 + 3 = " << {{PROJECT_NAME_ID}}::add(2, 3) << std::endl;
+
+    // Use Result for error handling (no exceptions)
+    auto result = {{PROJECT_NAME_ID}}::parse_int("42");
+    if (result.is_ok()) {
+        std::cout << "Parsed: " << result.value() << std::endl;
+    }
+
+    // Demonstrate error case
+    auto bad_result = {{PROJECT_NAME_ID}}::parse_int("not_a_number");
+    if (bad_result.is_err()) {
+        std::cout << "Error: " << bad_result.error() << std::endl;
+    }
+
+    return 0;
+}
+)";
+
 constexpr const char* header_only_hpp = R"(#pragma once
 
 #include <string>
@@ -484,6 +706,12 @@ constexpr const char* example_cpp = R"(#include <iostream>
 
 #include "{{PROJECT_NAME}}/{{PROJECT_NAME}}.hpp"
 
+// Present when the project was generated with --perf-counters
+#if __has_include("perf_counters.hpp")
+#include "perf_counters.hpp"
+#define EXAMPLE_HAS_PERF_COUNTERS 1
+#endif
+
 // =============================================================================
 // Example - Side Effect Boundary (all IO happens here)
 // =============================================================================
@@ -507,86 +735,1795 @@ int main() {
         std::cout << "Error: " << bad_result.error() << std::endl;
     }
 
+#ifdef EXAMPLE_HAS_PERF_COUNTERS
+    // Hardware counters for a batch of parse_int calls (Linux perf_event_open)
+    {{PROJECT_NAME_ID}}::perf::PerfCounters counters;
+    if (counters.available()) {
+        constexpr int calls = 100000;
+        const char* inputs[] = {"42", "-7", "12345", "oops"};
+        long long sum = 0;
+        {{PROJECT_NAME_ID}}::perf::ScopedReader reader(counters);
+        for (int i = 0; i < calls; ++i) {
+            auto parsed = {{PROJECT_NAME_ID}}::parse_int(inputs[i % 4]);
+            sum += parsed.is_ok() ? parsed.value() : 0;
+        }
+        if (auto values = reader.read()) {
+            std::cout << "parse_int x " << calls << " (sum " << sum
+                      << "): " << {{PROJECT_NAME_ID}}::perf::summary(*values, calls) << std::endl;
+        }
+    } else {
+        std::cout << "Hardware counters unavailable: " << counters.error() << std::endl;
+    }
+#endif
+
     return 0;
 }
 )";
 
-constexpr const char* test_main_cpp = R"(#include <cassert>
-#include <iostream>
-
+constexpr const char* test_main_cpp = R"(#include "test.hpp"
 #include "{{PROJECT_NAME}}/{{PROJECT_NAME}}.hpp"
 
 // =============================================================================
 // Tests for Pure Functions
 // =============================================================================
 
-void test_greet() {
-    assert({{PROJECT_NAME_ID}}::greet("World") == "Hello, World!");
-    assert({{PROJECT_NAME_ID}}::greet("") == "Hello, !");
-    std::cout << "[PASS] test_greet" << std::endl;
+TEST_CASE(greet) {
+    CHECK({{PROJECT_NAME_ID}}::greet("World") == "Hello, World!");
+    CHECK({{PROJECT_NAME_ID}}::greet("") == "Hello, !");
 }
 
-void test_add() {
-    assert({{PROJECT_NAME_ID}}::add(2, 3) == 5);
-    assert({{PROJECT_NAME_ID}}::add(-1, 1) == 0);
-    assert({{PROJECT_NAME_ID}}::add(0, 0) == 0);
-    std::cout << "[PASS] test_add" << std::endl;
+TEST_CASE(add) {
+    CHECK({{PROJECT_NAME_ID}}::add(2, 3) == 5);
+    CHECK({{PROJECT_NAME_ID}}::add(-1, 1) == 0);
+    CHECK({{PROJECT_NAME_ID}}::add(0, 0) == 0);
 }
 
-void test_parse_int_success() {
+TEST_CASE(parse_int_success) {
     auto result = {{PROJECT_NAME_ID}}::parse_int("42");
-    assert(result.is_ok());
-    assert(result.value() == 42);
+    CHECK(result.is_ok());
+    CHECK(result.value() == 42);
 
     auto negative = {{PROJECT_NAME_ID}}::parse_int("-123");
-    assert(negative.is_ok());
-    assert(negative.value() == -123);
-
-    std::cout << "[PASS] test_parse_int_success" << std::endl;
+    CHECK(negative.is_ok());
+    CHECK(negative.value() == -123);
 }
 
-void test_parse_int_failure() {
-    auto result = {{PROJECT_NAME_ID}}::parse_int("abc");
-    assert(result.is_err());
-
-    auto empty = {{PROJECT_NAME_ID}}::parse_int("");
-    assert(empty.is_err());
-
-    auto trailing = {{PROJECT_NAME_ID}}::parse_int("42abc");
-    assert(trailing.is_err());
-
-    std::cout << "[PASS] test_parse_int_failure" << std::endl;
+TEST_CASE(parse_int_failure) {
+    CHECK({{PROJECT_NAME_ID}}::parse_int("abc").is_err());
+    CHECK({{PROJECT_NAME_ID}}::parse_int("").is_err());
+    CHECK({{PROJECT_NAME_ID}}::parse_int("42abc").is_err());
 }
 
-void test_result_map() {
+TEST_CASE(result_map) {
     auto result = {{PROJECT_NAME_ID}}::parse_int("10");
     auto doubled = result.map([](int x) { return x * 2; });
-    assert(doubled.is_ok());
-    assert(doubled.value() == 20);
+    CHECK(doubled.is_ok());
+    CHECK(doubled.value() == 20);
 
     auto err = {{PROJECT_NAME_ID}}::parse_int("invalid");
     auto doubled_err = err.map([](int x) { return x * 2; });
-    assert(doubled_err.is_err());
+    CHECK(doubled_err.is_err());
+}
+
+// Usage: tests [--list | NAME]
+int main(int argc, char* argv[]) {
+    return {{PROJECT_NAME_ID}}::test::run(argc, argv);
+}
+)";
+
+// tests/test.hpp: always-on test harness used by test_main.cpp
+constexpr const char* test_hpp = R"(#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <string_view>
+#include <vector>
+
+namespace {{PROJECT_NAME_ID}}::test {
+
+// =============================================================================
+// Minimal Test Harness
+// =============================================================================
+//
+// CHECK is always compiled in, unlike assert(), so optimized builds with
+// -DNDEBUG still run every check. A failed CHECK reports file:line and lets
+// the test continue. The test binary accepts:
+//   tests           run every test
+//   tests NAME      run one test (CTest runs each test this way)
+//   tests --list    print the test names
+
+struct TestCase {
+    std::string_view name;
+    void (*fn)();
+};
 
-    std::cout << "[PASS] test_result_map" << std::endl;
+inline auto registry() -> std::vector<TestCase>& {
+    static std::vector<TestCase> tests;
+    return tests;
 }
 
-int main() {
-    std::cout << "Running tests for {{PROJECT_NAME}}..." << std::endl;
-    std::cout << std::endl;
+inline auto failure_count() -> int& {
+    static int count = 0;
+    return count;
+}
+
+struct Registrar {
+    Registrar(std::string_view name, void (*fn)()) { registry().push_back({name, fn}); }
+};
+
+inline void check(bool ok, const char* expr, const char* file, int line) {
+    if (!ok) {
+        ++failure_count();
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+}
+
+/**
+ * @brief Runs one test and prints PASS/FAIL with its wall time
+ */
+inline auto run_one(const TestCase& test) -> bool {
+    using Clock = std::chrono::steady_clock;
+    int failures_before = failure_count();
+    auto start = Clock::now();
+    try {
+        test.fn();
+    } catch (const std::exception& e) {
+        ++failure_count();
+        std::fprintf(stderr, "uncaught exception: %s\n", e.what());
+    } catch (...) {
+        ++failure_count();
+        std::fprintf(stderr, "uncaught non-standard exception\n");
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    bool passed = failure_count() == failures_before;
+    std::printf("[%s] %-32.*s %10.3f ms\n", passed ? "PASS" : "FAIL",
+                static_cast<int>(test.name.size()), test.name.data(), ms);
+    return passed;
+}
+
+/**
+ * @brief Entry point: returns 0 when every selected test passed
+ */
+inline auto run(int argc, char* argv[]) -> int {
+    std::string_view selected = argc > 1 ? argv[1] : "";
+    if (selected == "--list") {
+        for (const auto& test : registry()) {
+            std::printf("%.*s\n", static_cast<int>(test.name.size()), test.name.data());
+        }
+        return 0;
+    }
 
-    test_greet();
-    test_add();
-    test_parse_int_success();
-    test_parse_int_failure();
-    test_result_map();
+    int ran = 0;
+    int failed = 0;
+    for (const auto& test : registry()) {
+        if (!selected.empty() && test.name != selected) {
+            continue;
+        }
+        ++ran;
+        if (!run_one(test)) {
+            ++failed;
+        }
+    }
+    if (ran == 0) {
+        std::fprintf(stderr, "no test named '%.*s'\n", static_cast<int>(selected.size()),
+                     selected.data());
+        return 2;
+    }
+    std::printf("%d/%d tests passed\n", ran - failed, ran);
+    return failed == 0 ? 0 : 1;
+}
+
+} // namespace {{PROJECT_NAME_ID}}::test
+
+#define TEST_CASE(name)                                                                        \
+    static void test_##name();                                                                 \
+    static const ::{{PROJECT_NAME_ID}}::test::Registrar test_registrar_##name(#name,           \
+                                                                          &test_##name);   \
+    static void test_##name()
+
+#define CHECK(expr)                                                                            \
+    ::{{PROJECT_NAME_ID}}::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+)";
+
+// =============================================================================
+// Benchmark templates (--bench)
+// =============================================================================
+
+constexpr const char* bench_hpp = R"(#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {{PROJECT_NAME_ID}}::bench {
+
+// =============================================================================
+// Optimization Barriers
+// =============================================================================
+
+/**
+ * @brief Forces the compiler to treat value as used, so it cannot drop the work
+ */
+template <typename T> inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Like the const overload, but the compiler must also assume value changed
+ */
+template <typename T> inline void do_not_optimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+m"(value) : : "memory");
+#else
+    static volatile void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Forces all pending writes to be treated as observable
+ */
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+// =============================================================================
+// Measurement
+// =============================================================================
 
-    std::cout << std::endl;
-    std::cout << "All tests passed!" << std::endl;
+struct Config {
+    std::chrono::nanoseconds warmup = std::chrono::milliseconds(50);
+    std::chrono::nanoseconds min_sample_time = std::chrono::milliseconds(5);
+    int samples = 21;
+    int repetitions = 1; // measure this many times and keep the lowest median
+};
+
+struct Stats {
+    std::string_view name;
+    std::size_t iterations = 0; // calls per sample
+    int samples = 0;
+    double median_ns = 0; // per call
+    double mad_ns = 0;    // median absolute deviation, per call
+    double min_ns = 0;
+};
+
+namespace detail {
+
+inline auto median(std::vector<double> values) -> double {
+    std::sort(values.begin(), values.end());
+    auto n = values.size();
+    if (n == 0) {
+        return 0;
+    }
+    return n % 2 == 1 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+template <typename F> auto time_batch(F& fn, std::size_t iterations) -> double {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+} // namespace detail
+
+/**
+ * @brief Runs fn repeatedly and returns per-call timing statistics
+ *
+ * Warms up for config.warmup, doubles the batch size until one batch takes at
+ * least config.min_sample_time, then records config.samples batches.
+ */
+template <typename F>
+auto measure(std::string_view name, F&& fn, const Config& config = {}) -> Stats {
+    using Clock = std::chrono::steady_clock;
+    auto warmup_end = Clock::now() + config.warmup;
+    while (Clock::now() < warmup_end) {
+        fn();
+    }
+
+    auto min_sample_ns = static_cast<double>(config.min_sample_time.count());
+    std::size_t iterations = 1;
+    constexpr std::size_t max_iterations = std::size_t{1} << 30;
+    while (iterations < max_iterations && detail::time_batch(fn, iterations) < min_sample_ns) {
+        iterations *= 2;
+    }
+
+    std::vector<double> per_call;
+    per_call.reserve(static_cast<std::size_t>(config.samples));
+    for (int i = 0; i < config.samples; ++i) {
+        per_call.push_back(detail::time_batch(fn, iterations) / static_cast<double>(iterations));
+    }
+
+    Stats stats;
+    stats.name = name;
+    stats.iterations = iterations;
+    stats.samples = config.samples;
+    stats.median_ns = detail::median(per_call);
+    stats.min_ns = per_call.empty() ? 0 : *std::min_element(per_call.begin(), per_call.end());
+
+    std::vector<double> deviations;
+    deviations.reserve(per_call.size());
+    for (double t : per_call) {
+        deviations.push_back(std::abs(t - stats.median_ns));
+    }
+    stats.mad_ns = detail::median(std::move(deviations));
+    return stats;
+}
+
+/**
+ * @brief Prints one line: name, median per call, MAD relative to the median
+ */
+inline void print(const Stats& stats) {
+    double mad_pct = stats.median_ns > 0 ? 100.0 * stats.mad_ns / stats.median_ns : 0;
+    std::printf("%-32.*s %12.2f ns  +/- %5.1f%%  (%zu iterations x %d samples)\n",
+                static_cast<int>(stats.name.size()), stats.name.data(), stats.median_ns, mad_pct,
+                stats.iterations, stats.samples);
+}
+
+/**
+ * @brief Runs benchmarks whose name contains filter (all when empty) and prints them
+ */
+class Runner {
+  public:
+    explicit Runner(std::string_view filter = {}, Config config = {})
+        : filter_(filter), config_(config) {}
+
+    auto selected(std::string_view name) const -> bool {
+        return filter_.empty() || name.find(filter_) != std::string_view::npos;
+    }
+
+    template <typename F> void run(std::string_view name, F&& fn) {
+        if (!selected(name)) {
+            return;
+        }
+        if (!header_printed_) {
+            std::printf("%-32s %15s  %9s\n", "benchmark", "median", "MAD");
+            header_printed_ = true;
+        }
+        auto best = measure(name, fn, config_);
+        for (int i = 1; i < config_.repetitions; ++i) {
+            auto stats = measure(name, fn, config_);
+            if (stats.median_ns < best.median_ns) {
+                best = stats;
+            }
+        }
+        results_.push_back(best);
+        print(results_.back());
+    }
+
+    /**
+     * @brief Writes "name,median_ns,mad_ns" rows for bench/compare.cmake
+     */
+    auto write_csv(const std::string& path) const -> bool {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", path.c_str());
+            return false;
+        }
+        std::fprintf(file, "name,median_ns,mad_ns\n");
+        for (const auto& stats : results_) {
+            std::fprintf(file, "%.*s,%.3f,%.3f\n", static_cast<int>(stats.name.size()),
+                         stats.name.data(), stats.median_ns, stats.mad_ns);
+        }
+        return std::fclose(file) == 0;
+    }
+
+  private:
+    std::string_view filter_;
+    Config config_;
+    std::vector<Stats> results_;
+    bool header_printed_ = false;
+};
+
+} // namespace {{PROJECT_NAME_ID}}::bench
+)";
+
+constexpr const char* bench_main_cpp = R"(#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "{{PROJECT_NAME}}/{{PROJECT_NAME}}.hpp"
+
+// Present when the project was generated with --alloc-tracking / --perf-counters
+#if __has_include("alloc_tracking.hpp")
+#include "alloc_tracking.hpp"
+#define BENCH_HAS_ALLOC_TRACKING 1
+#endif
+#if __has_include("perf_counters.hpp")
+#include "perf_counters.hpp"
+#define BENCH_HAS_PERF_COUNTERS 1
+#endif
+
+// =============================================================================
+// Benchmarks - run all with: cmake --build build --target bench
+// Run a subset by name:      ./build/bench/{{PROJECT_NAME}}_bench parse_int
+// Save medians as CSV:       ./build/bench/{{PROJECT_NAME}}_bench --csv=results.csv
+// Keep the best of N runs:   ./build/bench/{{PROJECT_NAME}}_bench --repetitions=5
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    namespace bench = {{PROJECT_NAME_ID}}::bench;
+    std::string_view filter;
+    std::string csv_path;
+    bench::Config config;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.substr(0, 6) == "--csv=") {
+            csv_path = arg.substr(6);
+        } else if (arg.substr(0, 14) == "--repetitions=") {
+            config.repetitions = std::max(1, std::atoi(argv[i] + 14));
+        } else {
+            filter = arg;
+        }
+    }
+    bench::Runner runner(filter, config);
+
+#ifdef BENCH_HAS_PERF_COUNTERS
+    {{PROJECT_NAME_ID}}::perf::PerfCounters perf_counters;
+    if (!perf_counters.available()) {
+        std::printf("hardware counters unavailable: %s\n", perf_counters.error());
+    }
+#endif
+
+    // Times fn; also reports its heap allocations (-DTRACK_ALLOCATIONS=ON) and
+    // hardware counters per call when those modules are present
+    auto run = [&](std::string_view name, auto fn) {
+        runner.run(name, fn);
+#ifdef BENCH_HAS_ALLOC_TRACKING
+        if ({{PROJECT_NAME_ID}}::alloc_tracking::enabled && runner.selected(name)) {
+            {{PROJECT_NAME_ID}}::alloc_tracking::AllocationGuard guard;
+            fn();
+            std::printf("  %llu allocations, %llu bytes per call\n",
+                        static_cast<unsigned long long>(guard.allocations()),
+                        static_cast<unsigned long long>(guard.bytes()));
+        }
+#endif
+#ifdef BENCH_HAS_PERF_COUNTERS
+        if (perf_counters.available() && runner.selected(name)) {
+            constexpr std::uint64_t calls = 10000;
+            {{PROJECT_NAME_ID}}::perf::ScopedReader reader(perf_counters);
+            for (std::uint64_t i = 0; i < calls; ++i) {
+                fn();
+            }
+            if (auto values = reader.read()) {
+                std::printf("  %s\n", {{PROJECT_NAME_ID}}::perf::summary(*values, calls).c_str());
+            }
+        }
+#endif
+    };
+
+    run("greet", [] {
+        std::string_view name = "World";
+        bench::do_not_optimize(name);
+        auto message = {{PROJECT_NAME_ID}}::greet(name);
+        bench::do_not_optimize(message);
+    });
+
+    run("add", [] {
+        int a = 2;
+        int b = 3;
+        bench::do_not_optimize(a);
+        bench::do_not_optimize(b);
+        int sum = {{PROJECT_NAME_ID}}::add(a, b);
+        bench::do_not_optimize(sum);
+    });
+
+    run("parse_int/valid", [] {
+        std::string_view input = "12345";
+        bench::do_not_optimize(input);
+        auto result = {{PROJECT_NAME_ID}}::parse_int(input);
+        bench::do_not_optimize(result);
+    });
+
+    run("parse_int/invalid", [] {
+        std::string_view input = "not_a_number";
+        bench::do_not_optimize(input);
+        auto result = {{PROJECT_NAME_ID}}::parse_int(input);
+        bench::do_not_optimize(result);
+    });
+
+    if (!csv_path.empty() && !runner.write_csv(csv_path)) {
+        return 1;
+    }
     return 0;
 }
 )";
 
+constexpr const char* cmake_bench = R"(# Microbenchmarks (no external dependencies)
+# Run: cmake --build build --target bench
+if(NOT CMAKE_CONFIGURATION_TYPES AND NOT CMAKE_BUILD_TYPE MATCHES "^(Release|RelWithDebInfo)$")
+    message(WARNING "Benchmarks should be built with -DCMAKE_BUILD_TYPE=Release")
+endif()
+
+add_executable({{PROJECT_NAME}}_bench bench_main.cpp)
+target_link_libraries({{PROJECT_NAME}}_bench PRIVATE {{PROJECT_NAME}})
+
+add_custom_target(bench
+    COMMAND {{PROJECT_NAME}}_bench
+    DEPENDS {{PROJECT_NAME}}_bench
+    USES_TERMINAL
+    COMMENT "Running benchmarks"
+)
+)";
+
+constexpr const char* cmake_bench_exe = R"(# Microbenchmarks (no external dependencies)
+# Run: cmake --build build --target bench
+if(NOT CMAKE_CONFIGURATION_TYPES AND NOT CMAKE_BUILD_TYPE MATCHES "^(Release|RelWithDebInfo)$")
+    message(WARNING "Benchmarks should be built with -DCMAKE_BUILD_TYPE=Release")
+endif()
+
+# The functions under test are in {{PROJECT_NAME_ID}}_core (everything in src/
+# except main.cpp), the same library the application links
+add_executable({{PROJECT_NAME}}_bench bench_main.cpp)
+target_link_libraries({{PROJECT_NAME}}_bench PRIVATE {{PROJECT_NAME_ID}}_core)
+
+add_custom_target(bench
+    COMMAND {{PROJECT_NAME}}_bench
+    DEPENDS {{PROJECT_NAME}}_bench
+    USES_TERMINAL
+    COMMENT "Running benchmarks"
+)
+)";
+
+// Appended to bench/CMakeLists.txt: baseline recording and regression check
+constexpr const char* cmake_bench_compare = R"(
+# Regression check against a saved baseline (also run by CI on pull requests):
+#   git switch main   && cmake --build build --target bench-baseline
+#   git switch topic  && cmake --build build --target bench-compare
+set(BENCH_BASELINE "${CMAKE_BINARY_DIR}/bench-baseline.csv" CACHE FILEPATH
+    "Baseline CSV written by bench-baseline and read by bench-compare")
+set(BENCH_THRESHOLD_PCT 15 CACHE STRING
+    "bench-compare fails when a median is slower than the baseline by more than this percent")
+set(BENCH_NOISE_K 3 CACHE STRING
+    "...and the slowdown also exceeds this many times the summed MAD of both runs")
+set(BENCH_REPETITIONS 3 CACHE STRING
+    "Runs per benchmark in bench-baseline and bench-compare, the lowest median is kept")
+
+add_custom_target(bench-baseline
+    COMMAND {{PROJECT_NAME}}_bench --csv=${BENCH_BASELINE} --repetitions=${BENCH_REPETITIONS}
+    DEPENDS {{PROJECT_NAME}}_bench
+    USES_TERMINAL
+    COMMENT "Recording benchmark baseline in ${BENCH_BASELINE}"
+)
+
+add_custom_target(bench-compare
+    COMMAND {{PROJECT_NAME}}_bench --csv=${CMAKE_BINARY_DIR}/bench-current.csv
+            --repetitions=${BENCH_REPETITIONS}
+    COMMAND ${CMAKE_COMMAND}
+            -DBASELINE=${BENCH_BASELINE}
+            -DCURRENT=${CMAKE_BINARY_DIR}/bench-current.csv
+            -DTHRESHOLD=${BENCH_THRESHOLD_PCT}
+            -DNOISE_K=${BENCH_NOISE_K}
+            -P ${CMAKE_CURRENT_SOURCE_DIR}/compare.cmake
+    DEPENDS {{PROJECT_NAME}}_bench
+    USES_TERMINAL
+    COMMENT "Comparing benchmarks against ${BENCH_BASELINE}"
+)
+)";
+
+// bench/compare.cmake: compares two CSV files written by <name>_bench --csv=FILE
+constexpr const char* bench_compare_cmake = R"(# Compares benchmark medians and fails on regressions
+#
+#   cmake -DBASELINE=base.csv -DCURRENT=head.csv [-DTHRESHOLD=15] [-DNOISE_K=3]
+#         -P bench/compare.cmake
+#
+# Both files come from <name>_bench --csv=FILE. A benchmark regresses only when
+# its median is more than THRESHOLD percent slower than the baseline AND the
+# slowdown exceeds NOISE_K times the summed MAD of both runs, so differences
+# within run-to-run noise never fail the check. Benchmarks missing from either
+# side are reported but never fail it either.
+
+cmake_minimum_required(VERSION 3.20)
+
+if(NOT DEFINED THRESHOLD)
+    set(THRESHOLD 15)
+endif()
+if(NOT DEFINED NOISE_K)
+    set(NOISE_K 3)
+endif()
+foreach(input BASELINE CURRENT)
+    if(NOT EXISTS "${${input}}")
+        message(FATAL_ERROR "${input} file not found: '${${input}}'")
+    endif()
+endforeach()
+
+# Medians and MADs are written with three decimals; dropping the dot gives
+# picoseconds, which keeps the comparison in CMake's integer arithmetic.
+function(read_medians path prefix)
+    file(STRINGS "${path}" rows)
+    set(names "")
+    foreach(row IN LISTS rows)
+        if(row MATCHES "^([^,]+),([0-9]+)\\.([0-9][0-9][0-9]),([0-9]+)\\.([0-9][0-9][0-9])$")
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" key)
+            list(APPEND names "${CMAKE_MATCH_1}")
+            set(${prefix}_${key} "${CMAKE_MATCH_2}${CMAKE_MATCH_3}" PARENT_SCOPE)
+            set(${prefix}_mad_${key} "${CMAKE_MATCH_4}${CMAKE_MATCH_5}" PARENT_SCOPE)
+        endif()
+    endforeach()
+    set(${prefix}_names "${names}" PARENT_SCOPE)
+endfunction()
+
+function(format_ns picoseconds out)
+    math(EXPR whole "${picoseconds} / 1000")
+    math(EXPR frac "${picoseconds} % 1000")
+    string(LENGTH "${frac}" frac_len)
+    if(frac_len EQUAL 1)
+        set(frac "00${frac}")
+    elseif(frac_len EQUAL 2)
+        set(frac "0${frac}")
+    endif()
+    set(${out} "${whole}.${frac}" PARENT_SCOPE)
+endfunction()
+
+read_medians("${BASELINE}" base)
+read_medians("${CURRENT}" head)
+
+set(regressions "")
+math(EXPR threshold_permille "${THRESHOLD} * 10")
+foreach(name IN LISTS head_names)
+    string(MAKE_C_IDENTIFIER "${name}" key)
+    format_ns(${head_${key}} head_text)
+    if(NOT DEFINED base_${key})
+        message(STATUS "${name}: ${head_text} ns, new")
+        continue()
+    endif()
+    format_ns(${base_${key}} base_text)
+    if(base_${key} EQUAL 0)
+        message(STATUS "${name}: ${base_text} -> ${head_text} ns")
+        continue()
+    endif()
+
+    math(EXPR delta "${head_${key}} - ${base_${key}}")
+    math(EXPR change "${delta} * 1000 / ${base_${key}}")
+    math(EXPR noise "(${base_mad_${key}} + ${head_mad_${key}}) * ${NOISE_K}")
+    set(sign "+")
+    set(magnitude ${change})
+    if(change LESS 0)
+        set(sign "-")
+        math(EXPR magnitude "0 - ${change}")
+    endif()
+    math(EXPR pct_whole "${magnitude} / 10")
+    math(EXPR pct_frac "${magnitude} % 10")
+    set(line "${name}: ${base_text} -> ${head_text} ns, ${sign}${pct_whole}.${pct_frac}%")
+
+    if(change GREATER threshold_permille AND delta GREATER noise)
+        message(STATUS "${line}  REGRESSION")
+        list(APPEND regressions "${name}")
+    elseif(change GREATER threshold_permille)
+        format_ns(${noise} noise_text)
+        message(STATUS "${line}  within noise: ${noise_text} ns")
+    else()
+        message(STATUS "${line}")
+    endif()
+endforeach()
+
+foreach(name IN LISTS base_names)
+    if(NOT name IN_LIST head_names)
+        message(STATUS "${name}: removed")
+    endif()
+endforeach()
+
+if(regressions)
+    list(JOIN regressions ", " regressed)
+    message(FATAL_ERROR "Benchmarks slower than baseline by more than ${THRESHOLD}% "
+                        "and ${NOISE_K}x their MAD: ${regressed}")
+endif()
+message(STATUS "No benchmark regressed beyond ${THRESHOLD}% and the measurement noise")
+)";
+
+// Appended to ci.yml when both CI and --bench are enabled
+constexpr const char* github_ci_bench_job = R"(
+  bench:
+    # Runs the benchmarks on the merge base and on the pull request, then fails
+    # when a median regresses by more than BENCH_THRESHOLD_PCT percent and by
+    # more than the measurement noise (see bench/compare.cmake).
+    # Reproduce locally with the bench-baseline and bench-compare targets.
+    if: github.event_name == 'pull_request'
+    runs-on: ubuntu-latest
+    env:
+      BENCH_THRESHOLD_PCT: 15
+      BENCH_REPETITIONS: 3
+
+    steps:
+      - uses: actions/checkout@v4
+        with:
+          fetch-depth: 0
+
+      - name: Install Ninja
+        run: sudo apt-get update && sudo apt-get install -y ninja-build
+
+      - name: Benchmark merge base
+        id: base
+        run: |
+          base=$(git merge-base HEAD origin/${{ github.base_ref }})
+          git worktree add ../base "$base"
+          if [ ! -f ../base/bench/CMakeLists.txt ]; then
+            echo "Merge base has no benchmarks, skipping comparison"
+            echo "skip=true" >> "$GITHUB_OUTPUT"
+            exit 0
+          fi
+          cmake -S ../base --preset relwithdebinfo-perf -G Ninja
+          cmake --build ../base/build/relwithdebinfo-perf --target {{PROJECT_NAME}}_bench
+          ../base/build/relwithdebinfo-perf/bench/{{PROJECT_NAME}}_bench \
+            --csv="$PWD/bench-baseline.csv" --repetitions=$BENCH_REPETITIONS
+
+      - name: Benchmark pull request and compare
+        if: steps.base.outputs.skip != 'true'
+        run: |
+          cmake --preset relwithdebinfo-perf -G Ninja \
+            -DBENCH_BASELINE="$PWD/bench-baseline.csv" \
+            -DBENCH_THRESHOLD_PCT=$BENCH_THRESHOLD_PCT \
+            -DBENCH_REPETITIONS=$BENCH_REPETITIONS
+          cmake --build build/relwithdebinfo-perf --target bench-compare
+
+      - name: Upload benchmark results
+        if: always()
+        uses: actions/upload-artifact@v4
+        with:
+          name: bench-results
+          path: |
+            bench-baseline.csv
+            build/relwithdebinfo-perf/bench-current.csv
+          if-no-files-found: ignore
+)";
+
+// Appended to the top-level CMakeLists.txt when --bench is given
+constexpr const char* cmake_bench_option = R"(
+# Benchmarks
+option(BUILD_BENCHMARKS "Build benchmarks" ON)
+if(BUILD_BENCHMARKS)
+    add_subdirectory(bench)
+endif()
+)";
+
+// =============================================================================
+// Profile-guided optimization templates (--pgo)
+// =============================================================================
+
+// cmake/pgo.cmake: PGO_MODE option, compiler flags and the pgo-train target
+constexpr const char* cmake_pgo = R"(# Profile-guided optimization for GCC and Clang
+#
+# Train and rebuild in the same build directory (GCC keys profiles by object path):
+#   cmake -B build -DCMAKE_BUILD_TYPE=Release -DPGO_MODE=GENERATE
+#   cmake --build build --target pgo-train
+#   cmake -B build -DPGO_MODE=USE
+#   cmake --build build
+
+set(PGO_MODE "OFF" CACHE STRING "Profile-guided optimization: OFF, GENERATE or USE")
+set_property(CACHE PGO_MODE PROPERTY STRINGS OFF GENERATE USE)
+set(PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH "Directory holding PGO profiles")
+
+if(NOT PGO_MODE MATCHES "^(OFF|GENERATE|USE)$")
+    message(FATAL_ERROR "PGO_MODE must be OFF, GENERATE or USE, got '${PGO_MODE}'")
+endif()
+
+if(NOT PGO_MODE STREQUAL "OFF" AND NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+    message(WARNING "PGO_MODE=${PGO_MODE} needs GCC or Clang; building without PGO")
+    set(PGO_MODE "OFF")
+endif()
+
+if(PGO_MODE STREQUAL "GENERATE")
+    add_compile_options(-fprofile-generate=${PGO_PROFILE_DIR})
+    add_link_options(-fprofile-generate=${PGO_PROFILE_DIR})
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        # Thread-safe counters for multi-threaded training runs
+        add_compile_options(-fprofile-update=atomic)
+    endif()
+elseif(PGO_MODE STREQUAL "USE")
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        set(PGO_PROFDATA "${PGO_PROFILE_DIR}/default.profdata")
+        if(NOT EXISTS "${PGO_PROFDATA}")
+            message(WARNING "${PGO_PROFDATA} not found; run the pgo-train target first")
+        endif()
+        add_compile_options(-fprofile-use=${PGO_PROFDATA} -Wno-profile-instr-unprofiled)
+        add_link_options(-fprofile-use=${PGO_PROFDATA})
+    else()
+        add_compile_options(-fprofile-use=${PGO_PROFILE_DIR} -fprofile-correction -Wno-missing-profile)
+        add_link_options(-fprofile-use=${PGO_PROFILE_DIR})
+    endif()
+endif()
+
+# Clang writes raw profiles that must be merged with llvm-profdata
+if(PGO_MODE STREQUAL "GENERATE" AND CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    string(REGEX MATCH "^[0-9]+" PGO_CLANG_MAJOR "${CMAKE_CXX_COMPILER_VERSION}")
+    get_filename_component(PGO_COMPILER_DIR "${CMAKE_CXX_COMPILER}" DIRECTORY)
+    find_program(LLVM_PROFDATA
+        NAMES llvm-profdata llvm-profdata-${PGO_CLANG_MAJOR}
+        HINTS "${PGO_COMPILER_DIR}"
+    )
+    if(NOT LLVM_PROFDATA)
+        message(WARNING "llvm-profdata not found; merge ${PGO_PROFILE_DIR}/*.profraw manually")
+    endif()
+endif()
+
+# pgo-train runs a training workload: the benchmark if present, otherwise the
+# application, the example or the tests. Created once every target is defined.
+function(pgo_add_train_target)
+    if(NOT PGO_MODE STREQUAL "GENERATE")
+        return()
+    endif()
+
+    set(train_target "")
+    foreach(candidate {{PROJECT_NAME}}_bench ${PROJECT_NAME} example tests)
+        if(TARGET ${candidate})
+            get_target_property(candidate_type ${candidate} TYPE)
+            if(candidate_type STREQUAL "EXECUTABLE")
+                set(train_target ${candidate})
+                break()
+            endif()
+        endif()
+    endforeach()
+    if(NOT train_target)
+        message(WARNING "pgo-train: no executable to train with")
+        return()
+    endif()
+
+    set(merge_command "")
+    if(LLVM_PROFDATA)
+        set(merge_command
+            COMMAND ${CMAKE_COMMAND} -DLLVM_PROFDATA=${LLVM_PROFDATA}
+                    -DPGO_PROFILE_DIR=${PGO_PROFILE_DIR}
+                    -P ${PROJECT_SOURCE_DIR}/cmake/pgo_merge.cmake
+        )
+    endif()
+
+    add_custom_target(pgo-train
+        COMMAND ${CMAKE_COMMAND} -E rm -rf ${PGO_PROFILE_DIR}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${PGO_PROFILE_DIR}
+        COMMAND $<TARGET_FILE:${train_target}>
+        ${merge_command}
+        DEPENDS ${train_target}
+        WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+        USES_TERMINAL
+        COMMENT "Training PGO profile with ${train_target}"
+    )
+endfunction()
+
+cmake_language(DEFER DIRECTORY ${PROJECT_SOURCE_DIR} CALL pgo_add_train_target)
+)";
+
+// cmake/pgo_merge.cmake: script run by pgo-train to merge Clang profiles
+constexpr const char* cmake_pgo_merge = R"(# Merges Clang raw profiles into default.profdata (invoked by the pgo-train target)
+file(GLOB raw_profiles "${PGO_PROFILE_DIR}/*.profraw")
+if(NOT raw_profiles)
+    message(FATAL_ERROR "No .profraw files in ${PGO_PROFILE_DIR}; did the training run succeed?")
+endif()
+
+execute_process(
+    COMMAND ${LLVM_PROFDATA} merge -output=${PGO_PROFILE_DIR}/default.profdata ${raw_profiles}
+    RESULT_VARIABLE merge_result
+)
+if(NOT merge_result EQUAL 0)
+    message(FATAL_ERROR "llvm-profdata merge failed")
+endif()
+)";
+
+// Inserted near the top of CMakeLists.txt (before any target) when --pgo is given
+constexpr const char* cmake_pgo_include = R"(
+# Profile-guided optimization: -DPGO_MODE=GENERATE|USE (see cmake/pgo.cmake)
+include(cmake/pgo.cmake)
+)";
+
+// =============================================================================
+// Link-time optimization templates (--lto)
+// =============================================================================
+
+// cmake/lto.cmake: ENABLE_LTO option, IPO check, archiver and enable_lto()
+constexpr const char* cmake_lto = R"(# Link-time optimization via CheckIPOSupported
+#
+# enable_lto(<target>) turns on INTERPROCEDURAL_OPTIMIZATION for Release and
+# MinSizeRel; Debug and RelWithDebInfo builds keep their fast links.
+# Configure with -DENABLE_LTO=OFF to disable it entirely.
+
+option(ENABLE_LTO "Link-time optimization for Release builds" ON)
+
+set(LTO_SUPPORTED NO)
+if(ENABLE_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT LTO_SUPPORTED OUTPUT lto_check_output LANGUAGES CXX)
+    if(NOT LTO_SUPPORTED)
+        message(STATUS "LTO: not supported by this toolchain, building without it")
+        message(VERBOSE "${lto_check_output}")
+    endif()
+endif()
+
+if(LTO_SUPPORTED AND CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    # ThinLTO links in parallel and incrementally, with most of full LTO's gains
+    if(NOT CMAKE_CXX_COMPILE_OPTIONS_IPO MATCHES "thin")
+        include(CheckCXXCompilerFlag)
+        check_cxx_compiler_flag(-flto=thin HAS_THIN_LTO)
+        if(HAS_THIN_LTO)
+            set(CMAKE_CXX_COMPILE_OPTIONS_IPO -flto=thin)
+        endif()
+    endif()
+endif()
+
+# Static libraries of LTO objects need the plugin-aware gcc-ar / llvm-ar;
+# plain ar drops the symbol index and the final link fails. CMake archives
+# IPO targets with CMAKE_CXX_COMPILER_AR, so only step in when that is not
+# one of them. (Apple's ar and ld64 handle LTO objects on their own.)
+set(lto_ar_ok NO)
+if(EXISTS "${CMAKE_CXX_COMPILER_AR}" AND EXISTS "${CMAKE_CXX_COMPILER_RANLIB}")
+    get_filename_component(lto_ar_name "${CMAKE_CXX_COMPILER_AR}" NAME)
+    if(lto_ar_name MATCHES "gcc-ar|llvm-ar")
+        set(lto_ar_ok YES)
+    endif()
+endif()
+
+if(LTO_SUPPORTED AND CMAKE_CXX_COMPILER_ID MATCHES "^(GNU|Clang)$" AND NOT lto_ar_ok)
+    string(REGEX MATCH "^[0-9]+" lto_compiler_major "${CMAKE_CXX_COMPILER_VERSION}")
+    get_filename_component(lto_compiler_dir "${CMAKE_CXX_COMPILER}" DIRECTORY)
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        set(lto_ar_names gcc-ar-${lto_compiler_major} gcc-ar)
+        set(lto_ranlib_names gcc-ranlib-${lto_compiler_major} gcc-ranlib)
+    else()
+        set(lto_ar_names llvm-ar-${lto_compiler_major} llvm-ar)
+        set(lto_ranlib_names llvm-ranlib-${lto_compiler_major} llvm-ranlib)
+    endif()
+    find_program(LTO_AR NAMES ${lto_ar_names} HINTS "${lto_compiler_dir}")
+    find_program(LTO_RANLIB NAMES ${lto_ranlib_names} HINTS "${lto_compiler_dir}")
+    if(LTO_AR AND LTO_RANLIB)
+        set(CMAKE_CXX_ARCHIVE_CREATE_IPO "\"${LTO_AR}\" cr <TARGET> <LINK_FLAGS> <OBJECTS>")
+        set(CMAKE_CXX_ARCHIVE_APPEND_IPO "\"${LTO_AR}\" r <TARGET> <LINK_FLAGS> <OBJECTS>")
+        set(CMAKE_CXX_ARCHIVE_FINISH_IPO "\"${LTO_RANLIB}\" <TARGET>")
+    else()
+        message(STATUS "LTO: no LTO-aware archiver found, building without it")
+        set(LTO_SUPPORTED NO)
+    endif()
+endif()
+
+if(LTO_SUPPORTED)
+    list(JOIN CMAKE_CXX_COMPILE_OPTIONS_IPO " " lto_flags)
+    message(STATUS "LTO: enabled for Release builds with ${lto_flags}")
+endif()
+
+function(enable_lto target)
+    get_target_property(target_type ${target} TYPE)
+    if(NOT LTO_SUPPORTED OR target_type STREQUAL "INTERFACE_LIBRARY")
+        return()
+    endif()
+    set_target_properties(${target} PROPERTIES
+        INTERPROCEDURAL_OPTIMIZATION_RELEASE ON
+        INTERPROCEDURAL_OPTIMIZATION_MINSIZEREL ON
+    )
+endfunction()
+)";
+
+// Inserted near the top of CMakeLists.txt (before any target) when --lto is given
+constexpr const char* cmake_lto_include = R"(
+# Link-time optimization: -DENABLE_LTO=ON|OFF (see cmake/lto.cmake)
+include(cmake/lto.cmake)
+)";
+
+// Appended to the top-level CMakeLists.txt when --lto is given
+constexpr const char* cmake_lto_targets = R"(
+# Link-time optimization for the shipped targets (Release builds)
+foreach(lto_target ${PROJECT_NAME} example {{PROJECT_NAME}}_bench {{PROJECT_NAME_ID}}_core)
+    if(TARGET ${lto_target})
+        enable_lto(${lto_target})
+    endif()
+endforeach()
+)";
+
+// =============================================================================
+// Fast build templates (--fast-build)
+// =============================================================================
+
+// cmake/fast_build.cmake: unity builds and precompiled headers
+constexpr const char* cmake_fast_build = R"(# Faster compiles: unity builds and precompiled headers
+#
+# enable_fast_build(<target>) merges the target's sources into batches of
+# UNITY_BUILD_BATCH_SIZE files and precompiles pch/pch.hpp. Turn either off
+# with -DENABLE_UNITY_BUILD=OFF or -DENABLE_PCH=OFF, e.g. to check that every
+# source file still includes what it uses.
+
+option(ENABLE_UNITY_BUILD "Compile sources in unity batches" ON)
+set(UNITY_BUILD_BATCH_SIZE 16 CACHE STRING "Source files per unity batch, 0 puts the whole target in one")
+option(ENABLE_PCH "Precompile the standard headers listed in pch/pch.hpp" ON)
+
+function(enable_fast_build target)
+    get_target_property(target_type ${target} TYPE)
+    if(target_type STREQUAL "INTERFACE_LIBRARY")
+        return()
+    endif()
+    if(ENABLE_UNITY_BUILD)
+        set_target_properties(${target} PROPERTIES
+            UNITY_BUILD ON
+            UNITY_BUILD_BATCH_SIZE ${UNITY_BUILD_BATCH_SIZE}
+        )
+    endif()
+    if(ENABLE_PCH)
+        target_precompile_headers(${target} PRIVATE ${PROJECT_SOURCE_DIR}/pch/pch.hpp)
+    endif()
+endfunction()
+)";
+
+// pch/pch.hpp: heavy standard headers shared by every translation unit
+constexpr const char* pch_hpp = R"(#pragma once
+
+// Precompiled header (see cmake/fast_build.cmake). List only stable, widely
+// used headers here: any change rebuilds every target that uses it.
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+)";
+
+// Appended to the top-level CMakeLists.txt when --fast-build is given
+constexpr const char* cmake_fast_build_targets = R"(
+# Faster compiles: unity builds and precompiled headers (see cmake/fast_build.cmake)
+include(cmake/fast_build.cmake)
+foreach(fast_target ${PROJECT_NAME} tests example {{PROJECT_NAME}}_bench {{PROJECT_NAME_ID}}_core)
+    if(TARGET ${fast_target})
+        enable_fast_build(${fast_target})
+    endif()
+endforeach()
+)";
+
+// =============================================================================
+// Profiling templates (--profiling)
+// =============================================================================
+
+// cmake/profiling.cmake: profile-perf, profile-cachegrind and profile-heaptrack targets
+constexpr const char* cmake_profiling = R"(# Linux profiling targets: profile-perf, profile-cachegrind, profile-heaptrack
+#
+# Each target builds the profiled program, runs it under its tool through
+# tools/profile.sh and writes the reports to PROFILE_OUTPUT_DIR:
+#   cmake --build build --target profile-perf
+# Choose the program with -DPROFILE_TARGET=<target> and its arguments with
+# -DPROFILE_ARGS="...". perf unwinds with DWARF and frame pointers, so frame
+# pointers default to ON in projects generated with profiling support.
+
+set(ENABLE_FRAME_POINTERS ON CACHE BOOL "Keep frame pointers for profilers")
+set(PROFILE_TARGET "" CACHE STRING "Executable run by the profile-* targets, empty picks one")
+set(PROFILE_ARGS "" CACHE STRING "Arguments passed to the profiled executable")
+set(PROFILE_OUTPUT_DIR "${CMAKE_BINARY_DIR}/profiles" CACHE PATH "Directory for profiling reports")
+
+if(NOT CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    message(STATUS "Profiling: profile-* targets are only available on Linux")
+    return()
+endif()
+
+find_program(PERF_EXECUTABLE perf)
+find_program(VALGRIND_EXECUTABLE valgrind)
+find_program(HEAPTRACK_EXECUTABLE heaptrack)
+
+# Created once every target is defined, so the default can be the benchmark,
+# the example or the tests when there is no application
+function(profiling_add_targets)
+    set(profiled "${PROFILE_TARGET}")
+    if(NOT profiled)
+        foreach(candidate ${PROJECT_NAME} {{PROJECT_NAME}}_bench example tests)
+            if(TARGET ${candidate})
+                get_target_property(candidate_type ${candidate} TYPE)
+                if(candidate_type STREQUAL "EXECUTABLE")
+                    set(profiled ${candidate})
+                    break()
+                endif()
+            endif()
+        endforeach()
+    endif()
+    if(NOT profiled)
+        message(STATUS "Profiling: no executable to profile, set PROFILE_TARGET")
+        return()
+    endif()
+
+    separate_arguments(profile_args UNIX_COMMAND "${PROFILE_ARGS}")
+    set(perf_program ${PERF_EXECUTABLE})
+    set(cachegrind_program ${VALGRIND_EXECUTABLE})
+    set(heaptrack_program ${HEAPTRACK_EXECUTABLE})
+
+    set(available "")
+    foreach(tool perf cachegrind heaptrack)
+        if(${tool}_program)
+            list(APPEND available ${tool})
+            add_custom_target(profile-${tool}
+                COMMAND sh ${PROJECT_SOURCE_DIR}/tools/profile.sh
+                        ${tool} ${PROFILE_OUTPUT_DIR} $<TARGET_FILE:${profiled}> ${profile_args}
+                DEPENDS ${profiled}
+                WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+                USES_TERMINAL
+                VERBATIM
+                COMMENT "Profiling ${profiled} with ${tool}, reports go to ${PROFILE_OUTPUT_DIR}"
+            )
+        else()
+            add_custom_target(profile-${tool}
+                COMMAND ${CMAKE_COMMAND} -E echo
+                        "profile-${tool}: tool not found, install it and re-run CMake"
+                COMMAND ${CMAKE_COMMAND} -E false
+                VERBATIM
+            )
+        endif()
+    endforeach()
+
+    if(available)
+        list(JOIN available ", " available_text)
+        message(STATUS "Profiling: ${profiled} with ${available_text}")
+    else()
+        message(STATUS "Profiling: no tools found, install perf, valgrind or heaptrack")
+    endif()
+endfunction()
+
+cmake_language(DEFER DIRECTORY ${PROJECT_SOURCE_DIR} CALL profiling_add_targets)
+)";
+
+// tools/profile.sh: shared driver for the profile-* targets
+constexpr const char* profile_sh = R"(#!/bin/sh
+# Runs a program under perf, cachegrind or heaptrack and writes the reports
+# to OUT_DIR, named after the program and a timestamp.
+#
+#   sh tools/profile.sh perf|cachegrind|heaptrack OUT_DIR PROGRAM [ARGS...]
+#
+# The profile-perf, profile-cachegrind and profile-heaptrack CMake targets call
+# this script with the built program and OUT_DIR=build/profiles.
+set -eu
+
+if [ $# -lt 3 ]; then
+    echo "usage: $0 perf|cachegrind|heaptrack OUT_DIR PROGRAM [ARGS...]" >&2
+    exit 2
+fi
+
+tool=$1
+out_dir=$2
+program=$3
+shift 3
+
+mkdir -p "$out_dir"
+name=$(basename "$program")
+stamp=$(date +%Y%m%d-%H%M%S)
+prefix="$out_dir/$tool-$name-$stamp"
+
+require() {
+    if ! command -v "$1" >/dev/null 2>&1; then
+        echo "$1 not found in PATH" >&2
+        exit 1
+    fi
+}
+
+case $tool in
+perf)
+    require perf
+    paranoid=$(cat /proc/sys/kernel/perf_event_paranoid 2>/dev/null || echo 0)
+    if [ "$paranoid" -gt 2 ]; then
+        echo "note: kernel.perf_event_paranoid=$paranoid may block perf record;" \
+             "try: sudo sysctl kernel.perf_event_paranoid=1" >&2
+    fi
+    perf record --call-graph dwarf -F 999 -o "$prefix.data" -- "$program" "$@"
+    perf report -i "$prefix.data" --stdio --no-children >"$prefix.txt" 2>/dev/null || true
+    # Flame graph when Brendan Gregg's FlameGraph scripts or inferno are installed
+    if command -v stackcollapse-perf.pl >/dev/null 2>&1 && command -v flamegraph.pl >/dev/null 2>&1; then
+        perf script -i "$prefix.data" | stackcollapse-perf.pl | flamegraph.pl >"$prefix.svg"
+    elif command -v inferno-collapse-perf >/dev/null 2>&1 && command -v inferno-flamegraph >/dev/null 2>&1; then
+        perf script -i "$prefix.data" | inferno-collapse-perf | inferno-flamegraph >"$prefix.svg"
+    fi
+    ;;
+cachegrind)
+    require valgrind
+    valgrind --tool=cachegrind --cache-sim=yes --cachegrind-out-file="$prefix.out" "$program" "$@"
+    if command -v cg_annotate >/dev/null 2>&1; then
+        cg_annotate "$prefix.out" >"$prefix.txt"
+    fi
+    ;;
+heaptrack)
+    require heaptrack
+    heaptrack -o "$prefix" "$program" "$@"
+    if command -v heaptrack_print >/dev/null 2>&1; then
+        for data in "$prefix.zst" "$prefix.gz"; do
+            if [ -f "$data" ]; then
+                heaptrack_print "$data" >"$prefix.txt"
+            fi
+        done
+    fi
+    ;;
+*)
+    echo "unknown tool '$tool', expected perf, cachegrind or heaptrack" >&2
+    exit 2
+    ;;
+esac
+
+echo "Reports written to $out_dir:"
+ls -1 "$prefix".* 2>/dev/null || true
+)";
+
+// Inserted near the top of CMakeLists.txt (before any target) when --profiling is given
+constexpr const char* cmake_profiling_include = R"(
+# Linux profiling targets: profile-perf, profile-cachegrind, profile-heaptrack
+include(cmake/profiling.cmake)
+)";
+
+// =============================================================================
+// Allocation tracking templates (--alloc-tracking)
+// =============================================================================
+
+// cmake/alloc_tracking.cmake: TRACK_ALLOCATIONS option and the tracking library
+constexpr const char* cmake_alloc_tracking = R"(# Allocation tracking: per-thread heap allocation counters
+#
+#   cmake -B build -DTRACK_ALLOCATIONS=ON
+#
+# enable_alloc_tracking(<executable>) makes alloc/alloc_tracking.hpp available.
+# With TRACK_ALLOCATIONS=ON it also links alloc/alloc_tracking.cpp, which
+# replaces the global operator new/delete with counting versions. With OFF the
+# counters stay at zero and alloc_tracking::enabled is false, so keep it OFF
+# for builds you ship: every allocation pays for the bookkeeping.
+
+option(TRACK_ALLOCATIONS "Count heap allocations with replaced operator new/delete" OFF)
+
+if(TRACK_ALLOCATIONS)
+    # An OBJECT library, so the replacement operators end up in every executable
+    add_library({{PROJECT_NAME_ID}}_alloc_tracking OBJECT
+        ${PROJECT_SOURCE_DIR}/alloc/alloc_tracking.cpp)
+    target_include_directories({{PROJECT_NAME_ID}}_alloc_tracking
+        PUBLIC ${PROJECT_SOURCE_DIR}/alloc)
+    target_compile_definitions({{PROJECT_NAME_ID}}_alloc_tracking PUBLIC TRACK_ALLOCATIONS=1)
+    message(STATUS "Allocation tracking: enabled")
+else()
+    add_library({{PROJECT_NAME_ID}}_alloc_tracking INTERFACE)
+    target_include_directories({{PROJECT_NAME_ID}}_alloc_tracking
+        INTERFACE ${PROJECT_SOURCE_DIR}/alloc)
+endif()
+
+# Libraries are skipped: the operators belong to the final executable only
+function(enable_alloc_tracking target)
+    get_target_property(target_type ${target} TYPE)
+    if(target_type STREQUAL "EXECUTABLE")
+        target_link_libraries(${target} PRIVATE {{PROJECT_NAME_ID}}_alloc_tracking)
+    endif()
+endfunction()
+)";
+
+// alloc/alloc_tracking.hpp: counters and AllocationGuard
+constexpr const char* alloc_tracking_hpp = R"(#pragma once
+
+#include <cstdint>
+
+namespace {{PROJECT_NAME_ID}}::alloc_tracking {
+
+// =============================================================================
+// Allocation Tracking (cmake -DTRACK_ALLOCATIONS=ON)
+// =============================================================================
+//
+// With TRACK_ALLOCATIONS the global operator new/delete count every call
+// (alloc_tracking.cpp). Counters are per thread: a guard only sees the
+// allocations of the thread that created it. Without TRACK_ALLOCATIONS every
+// counter reads zero, so check `enabled` before asserting that code allocates.
+
+#if defined(TRACK_ALLOCATIONS) && TRACK_ALLOCATIONS
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+struct AllocationStats {
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t bytes = 0; // requested bytes, not including allocator overhead
+};
+
+inline auto operator-(AllocationStats a, AllocationStats b) noexcept -> AllocationStats {
+    return {a.allocations - b.allocations, a.deallocations - b.deallocations, a.bytes - b.bytes};
+}
+
+/**
+ * @brief Totals for the calling thread since it started
+ */
+#if defined(TRACK_ALLOCATIONS) && TRACK_ALLOCATIONS
+auto thread_stats() noexcept -> AllocationStats;
+#else
+inline auto thread_stats() noexcept -> AllocationStats {
+    return {};
+}
+#endif
+
+/**
+ * @brief Counts the calling thread's allocations from construction onward
+ *
+ *   AllocationGuard guard;
+ *   auto sum = add(2, 3);
+ *   CHECK(guard.allocations() == 0);
+ */
+class AllocationGuard {
+  public:
+    AllocationGuard() noexcept : start_(thread_stats()) {}
+
+    auto stats() const noexcept -> AllocationStats { return thread_stats() - start_; }
+
+    auto allocations() const noexcept -> std::uint64_t { return stats().allocations; }
+
+    auto bytes() const noexcept -> std::uint64_t { return stats().bytes; }
+
+  private:
+    AllocationStats start_;
+};
+
+} // namespace {{PROJECT_NAME_ID}}::alloc_tracking
+)";
+
+// alloc/alloc_tracking.cpp: counting global operator new/delete
+constexpr const char* alloc_tracking_cpp = R"(#include "alloc_tracking.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Replaces the global allocation functions; only built with TRACK_ALLOCATIONS=ON.
+// The counters are plain thread_local integers: no atomics, no locks, and no
+// allocations of their own.
+
+namespace {
+
+thread_local {{PROJECT_NAME_ID}}::alloc_tracking::AllocationStats t_stats;
+
+auto count(void* p, std::size_t size) noexcept -> void* {
+    if (p != nullptr) {
+        ++t_stats.allocations;
+        t_stats.bytes += size;
+    }
+    return p;
+}
+
+auto counted_alloc(std::size_t size) noexcept -> void* {
+    return count(std::malloc(size == 0 ? 1 : size), size);
+}
+
+auto counted_aligned_alloc(std::size_t size, std::align_val_t align) noexcept -> void* {
+    auto alignment = static_cast<std::size_t>(align);
+    // aligned_alloc needs a non-zero size that is a multiple of the alignment
+    std::size_t rounded = size == 0 ? alignment : (size + alignment - 1) / alignment * alignment;
+    if (rounded < size) {
+        return nullptr;
+    }
+#ifdef _WIN32
+    return count(_aligned_malloc(rounded, alignment), size);
+#else
+    return count(std::aligned_alloc(alignment, rounded), size);
+#endif
+}
+
+// Like the standard operator new: on failure run the new-handler and retry,
+// throw std::bad_alloc once there is no handler left
+template <typename Alloc>
+auto alloc_or_throw(Alloc alloc) -> void* {
+    void* p = nullptr;
+    while ((p = alloc()) == nullptr) {
+        if (auto handler = std::get_new_handler()) {
+            handler();
+        } else {
+            throw std::bad_alloc{};
+        }
+    }
+    return p;
+}
+
+auto counted_free(void* p) noexcept -> void {
+    if (p != nullptr) {
+        ++t_stats.deallocations;
+    }
+    std::free(p);
+}
+
+auto counted_aligned_free(void* p) noexcept -> void {
+    if (p != nullptr) {
+        ++t_stats.deallocations;
+    }
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // anonymous namespace
+
+namespace {{PROJECT_NAME_ID}}::alloc_tracking {
+
+auto thread_stats() noexcept -> AllocationStats {
+    return t_stats;
+}
+
+} // namespace {{PROJECT_NAME_ID}}::alloc_tracking
+
+auto operator new(std::size_t size) -> void* {
+    return alloc_or_throw([size] { return counted_alloc(size); });
+}
+
+auto operator new[](std::size_t size) -> void* {
+    return ::operator new(size);
+}
+
+// The nothrow versions also run the new-handler, but return null instead of throwing
+auto operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept -> void* {
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t& tag) noexcept -> void* {
+    return ::operator new(size, tag);
+}
+
+auto operator new(std::size_t size, std::align_val_t align) -> void* {
+    return alloc_or_throw([size, align] { return counted_aligned_alloc(size, align); });
+}
+
+auto operator new[](std::size_t size, std::align_val_t align) -> void* {
+    return ::operator new(size, align);
+}
+
+auto operator delete(void* p) noexcept -> void {
+    counted_free(p);
+}
+
+auto operator delete[](void* p) noexcept -> void {
+    counted_free(p);
+}
+
+auto operator delete(void* p, std::size_t /*size*/) noexcept -> void {
+    counted_free(p);
+}
+
+auto operator delete[](void* p, std::size_t /*size*/) noexcept -> void {
+    counted_free(p);
+}
+
+auto operator delete(void* p, std::align_val_t /*align*/) noexcept -> void {
+    counted_aligned_free(p);
+}
+
+auto operator delete[](void* p, std::align_val_t /*align*/) noexcept -> void {
+    counted_aligned_free(p);
+}
+
+auto operator delete(void* p, std::size_t /*size*/, std::align_val_t /*align*/) noexcept -> void {
+    counted_aligned_free(p);
+}
+
+auto operator delete[](void* p, std::size_t /*size*/, std::align_val_t /*align*/) noexcept
+    -> void {
+    counted_aligned_free(p);
+}
+)";
+
+// Appended to the top-level CMakeLists.txt when --alloc-tracking is given
+constexpr const char* cmake_alloc_tracking_targets = R"(
+# Allocation tracking: -DTRACK_ALLOCATIONS=ON (see cmake/alloc_tracking.cmake)
+include(cmake/alloc_tracking.cmake)
+foreach(alloc_target ${PROJECT_NAME} tests example {{PROJECT_NAME}}_bench)
+    if(TARGET ${alloc_target})
+        enable_alloc_tracking(${alloc_target})
+    endif()
+endforeach()
+)";
+
+// Inserted into tests/test_main.cpp when --alloc-tracking is given
+constexpr const char* test_alloc_tracking_include = R"(#include "alloc_tracking.hpp"
+
+#include <new>
+)";
+
+constexpr const char* test_alloc_tracking_cases = R"(// =============================================================================
+// Allocation Tests (cmake -DTRACK_ALLOCATIONS=ON)
+// =============================================================================
+
+TEST_CASE(add_does_not_allocate) {
+    {{PROJECT_NAME_ID}}::alloc_tracking::AllocationGuard guard;
+    CHECK({{PROJECT_NAME_ID}}::add(2, 3) == 5);
+    CHECK(guard.allocations() == 0);
+}
+
+TEST_CASE(greet_allocates) {
+    {{PROJECT_NAME_ID}}::alloc_tracking::AllocationGuard guard;
+    // Longer than any small-string buffer, so the result lives on the heap
+    auto message = {{PROJECT_NAME_ID}}::greet("allocation tracking");
+    CHECK(message.size() > 23);
+    CHECK(!{{PROJECT_NAME_ID}}::alloc_tracking::enabled || guard.allocations() >= 1);
+}
+
+// Only the counting operator new is under test. AddressSanitizer aborts on the
+// oversized request instead of returning null, so the case does nothing there.
+#if defined(__SANITIZE_ADDRESS__)
+constexpr bool address_sanitizer = true;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+constexpr bool address_sanitizer = true;
+#else
+constexpr bool address_sanitizer = false;
+#endif
+#else
+constexpr bool address_sanitizer = false;
+#endif
+
+TEST_CASE(failed_new_calls_the_new_handler) {
+    // operator new retries through the new-handler before throwing std::bad_alloc
+    if constexpr ({{PROJECT_NAME_ID}}::alloc_tracking::enabled && !address_sanitizer) {
+        static int handler_calls = 0;
+        auto previous = std::set_new_handler([] {
+            ++handler_calls;
+            std::set_new_handler(nullptr);
+        });
+        bool threw = false;
+        try {
+            void* volatile p = ::operator new(static_cast<std::size_t>(-1) / 2);
+            ::operator delete(p);
+        } catch (const std::bad_alloc&) {
+            threw = true;
+        }
+        std::set_new_handler(previous);
+        CHECK(threw);
+        CHECK(handler_calls == 1);
+    }
+}
+
+)";
+
+// =============================================================================
+// Hardware performance counter templates (--perf-counters)
+// =============================================================================
+
+// perf/perf_counters.hpp: cycles, instructions, cache and branch misses
+constexpr const char* perf_counters_hpp = R"(#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_COUNTERS_LINUX 1
+#endif
+
+namespace {{PROJECT_NAME_ID}}::perf {
+
+// =============================================================================
+// Hardware Performance Counters (Linux perf_event_open)
+// =============================================================================
+//
+// Counts user-space cycles, instructions, cache misses and branch misses of
+// the calling thread as one group, so all four cover the same interval.
+// When the kernel refuses (perf_event_paranoid, containers, VMs without a
+// PMU) or on other platforms, available() is false and error() says why;
+// callers just skip the report.
+//
+//   perf::PerfCounters counters;
+//   perf::ScopedReader reader(counters);
+//   work();
+//   if (auto values = reader.read()) {
+//       std::puts(perf::summary(*values, 1).c_str());
+//   }
+
+struct CounterValues {
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t cache_misses = 0;
+    std::uint64_t branch_misses = 0;
+
+    auto ipc() const noexcept -> double {
+        return cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+
+    // Misses per thousand instructions
+    auto cache_mpki() const noexcept -> double { return per_kilo_instruction(cache_misses); }
+
+    auto branch_mpki() const noexcept -> double { return per_kilo_instruction(branch_misses); }
+
+  private:
+    auto per_kilo_instruction(std::uint64_t count) const noexcept -> double {
+        return instructions == 0
+                   ? 0.0
+                   : 1000.0 * static_cast<double>(count) / static_cast<double>(instructions);
+    }
+};
+
+/**
+ * @brief One line: cycles per operation, IPC and miss rates
+ */
+inline auto summary(const CounterValues& values, std::uint64_t ops) -> std::string {
+    double n = ops == 0 ? 1.0 : static_cast<double>(ops);
+    std::array<char, 160> buffer{};
+    std::snprintf(buffer.data(), buffer.size(),
+                  "%.1f cycles/op, IPC %.2f, cache misses %.2f/1k instr, "
+                  "branch misses %.2f/1k instr",
+                  static_cast<double>(values.cycles) / n, values.ipc(), values.cache_mpki(),
+                  values.branch_mpki());
+    return buffer.data();
+}
+
+class PerfCounters {
+  public:
+    PerfCounters() noexcept { open(); }
+
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    auto operator=(const PerfCounters&) -> PerfCounters& = delete;
+
+    auto available() const noexcept -> bool { return fds_[0] != -1; }
+
+    // Why the counters are unavailable, empty when they work
+    auto error() const noexcept -> const char* { return error_; }
+
+    auto start() noexcept -> void {
+#ifdef PERF_COUNTERS_LINUX
+        if (available()) {
+            ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stops counting; empty when unavailable or the group never ran
+     */
+    auto stop() noexcept -> std::optional<CounterValues> {
+#ifdef PERF_COUNTERS_LINUX
+        if (!available()) {
+            return std::nullopt;
+        }
+        ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, values[nr]
+        std::array<std::uint64_t, 3 + event_count> data{};
+        auto expected = static_cast<ssize_t>(sizeof(data));
+        if (::read(fds_[0], data.data(), sizeof(data)) != expected || data[2] == 0) {
+            return std::nullopt;
+        }
+        // Scale up when the kernel multiplexed the group with other events
+        double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        auto scaled = [&](std::size_t i) {
+            return static_cast<std::uint64_t>(static_cast<double>(data[3 + i]) * scale);
+        };
+        return CounterValues{scaled(0), scaled(1), scaled(2), scaled(3)};
+#else
+        return std::nullopt;
+#endif
+    }
+
+  private:
+    static constexpr std::size_t event_count = 4;
+
+    std::array<int, event_count> fds_{-1, -1, -1, -1};
+    const char* error_ = "";
+
+    auto open() noexcept -> void {
+#ifdef PERF_COUNTERS_LINUX
+        constexpr std::array<std::uint64_t, event_count> events{
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (std::size_t i = 0; i < event_count; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = events[i];
+            attr.disabled = i == 0 ? 1 : 0; // members follow the group leader
+            attr.exclude_kernel = 1;         // allowed with perf_event_paranoid <= 2
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, fds_[0], 0));
+            if (fds_[i] == -1) {
+                error_ = describe(errno);
+                close();
+                return;
+            }
+        }
+#else
+        error_ = "hardware counters need Linux perf_event_open";
+#endif
+    }
+
+    auto close() noexcept -> void {
+#ifdef PERF_COUNTERS_LINUX
+        for (int& fd : fds_) {
+            if (fd != -1) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+#ifdef PERF_COUNTERS_LINUX
+    static auto describe(int error) noexcept -> const char* {
+        switch (error) {
+        case EACCES:
+        case EPERM:
+            return "not permitted, see /proc/sys/kernel/perf_event_paranoid";
+        case ENOENT:
+        case EOPNOTSUPP:
+            return "hardware events are not supported on this CPU or VM";
+        case ENOSYS:
+            return "perf_event_open is not available in this kernel";
+        default:
+            return "perf_event_open failed";
+        }
+    }
+#endif
+};
+
+/**
+ * @brief Counts from construction until read(); stops counting if never read
+ */
+class ScopedReader {
+  public:
+    explicit ScopedReader(PerfCounters& counters) noexcept : counters_(counters) {
+        counters_.start();
+    }
+
+    ~ScopedReader() {
+        if (!done_) {
+            counters_.stop();
+        }
+    }
+
+    ScopedReader(const ScopedReader&) = delete;
+    auto operator=(const ScopedReader&) -> ScopedReader& = delete;
+
+    auto read() noexcept -> std::optional<CounterValues> {
+        done_ = true;
+        return counters_.stop();
+    }
+
+  private:
+    PerfCounters& counters_;
+    bool done_ = false;
+};
+
+} // namespace {{PROJECT_NAME_ID}}::perf
+)";
+
+// Appended to the top-level CMakeLists.txt when --perf-counters is given
+constexpr const char* cmake_perf_counters_targets = R"(
+# Hardware performance counters for the executables (Linux, see perf/perf_counters.hpp)
+add_library({{PROJECT_NAME_ID}}_perf_counters INTERFACE)
+target_include_directories({{PROJECT_NAME_ID}}_perf_counters INTERFACE ${PROJECT_SOURCE_DIR}/perf)
+foreach(perf_target ${PROJECT_NAME} tests example {{PROJECT_NAME}}_bench)
+    if(TARGET ${perf_target})
+        get_target_property(perf_target_type ${perf_target} TYPE)
+        if(perf_target_type STREQUAL "EXECUTABLE")
+            target_link_libraries(${perf_target} PRIVATE {{PROJECT_NAME_ID}}_perf_counters)
+        endif()
+    endif()
+endforeach()
+)";
+
 // =============================================================================
 // Config file templates
 // =============================================================================
@@ -609,6 +2546,9 @@ out/
 # Compile commands (generated)
 compile_commands.json
 
+# Local CMake presets
+CMakeUserPresets.json
+
 # Object files
 *.o
 *.obj
@@ -767,6 +2707,21 @@ cmake -B build -G Ninja
 cmake --build build
 ```
 
+Or use a preset from `CMakePresets.json` (CMake 3.21+):
+
+| Preset | Purpose |
+|--------|---------|
+| `debug` | Debug build |
+| `release` | Optimized build |
+| `relwithdebinfo-perf` | `-O2 -g` with frame pointers, for profilers |
+| `release-native` | Release tuned for the host CPU (`-march=native`) |
+| `release-lto` | Release with link-time optimization |
+
+```bash
+cmake --preset release
+cmake --build --preset release
+```
+
 ## Usage
 
 ```bash
@@ -791,6 +2746,21 @@ cmake -B build -G Ninja
 cmake --build build
 ```
 
+Or use a preset from `CMakePresets.json` (CMake 3.21+):
+
+| Preset | Purpose |
+|--------|---------|
+| `debug` | Debug build |
+| `release` | Optimized build |
+| `relwithdebinfo-perf` | `-O2 -g` with frame pointers, for profilers |
+| `release-native` | Release tuned for the host CPU (`-march=native`) |
+| `release-lto` | Release with link-time optimization |
+
+```bash
+cmake --preset release
+cmake --build --preset release
+```
+
 ## Usage
 
 ```cpp
@@ -841,40 +2811,85 @@ jobs:
 
     runs-on: ${{ matrix.os }}
 
+    env:
+      CCACHE_DIR: ${{ github.workspace }}/.ccache
+      CCACHE_MAXSIZE: 500M
+      SCCACHE_DIR: ${{ github.workspace }}/.sccache
+      SCCACHE_CACHE_SIZE: 500M
+
     steps:
       - uses: actions/checkout@v4
 
+      - name: Install Ninja and ccache (Linux)
+        if: runner.os == 'Linux'
+        run: sudo apt-get update && sudo apt-get install -y ninja-build ccache
+
+      - name: Install Ninja and ccache (macOS)
+        if: runner.os == 'macOS'
+        run: brew install ninja ccache
+
+      - name: Install Ninja and sccache (Windows)
+        if: runner.os == 'Windows'
+        run: choco install -y ninja sccache
+
+      - name: Set up MSVC environment
+        if: runner.os == 'Windows'
+        uses: ilammy/msvc-dev-cmd@v1
+
+      # The cache is keyed on the compiler version and on every file that pins
+      # dependencies or build flags; each run saves a fresh entry keyed on the
+      # commit and restores the newest entry sharing the same prefix.
+      - name: Compute cache key
+        id: cache-key
+        shell: bash
+        run: |
+          if [ "$RUNNER_OS" = "Windows" ]; then
+            cl 2> compiler-version.txt || true
+          else
+            c++ --version > compiler-version.txt
+          fi
+          compiler=$(cmake -E sha256sum compiler-version.txt | cut -c1-16)
+          echo "prefix=${RUNNER_OS}-cc-${compiler}-${{ hashFiles('**/CMakeLists.txt', 'cmake/**', 'CMakePresets.json', 'vcpkg.json', 'conanfile.txt', 'conan.lock') }}" >> "$GITHUB_OUTPUT"
+
+      - name: Restore compiler cache
+        uses: actions/cache@v4
+        with:
+          path: |
+            .ccache
+            .sccache
+          key: ${{ steps.cache-key.outputs.prefix }}-${{ github.sha }}
+          restore-keys: |
+            ${{ steps.cache-key.outputs.prefix }}-
+
       - name: Configure CMake
-        run: cmake -B build -DCMAKE_BUILD_TYPE=Release -DBUILD_TESTING=ON
+        run: cmake -B build -G Ninja -DCMAKE_BUILD_TYPE=Release -DBUILD_TESTING=ON
 
       - name: Build
-        run: cmake --build build --config Release
+        run: cmake --build build
 
-      - name: Run tests (Unix)
-        if: runner.os != 'Windows'
-        run: ctest --test-dir build --output-on-failure
+      - name: Run tests
+        run: ctest --test-dir build --output-on-failure -j 4
 
-      - name: Run tests (Windows)
-        if: runner.os == 'Windows'
-        working-directory: build
-        run: ctest --output-on-failure -C Release
+      - name: Compiler cache statistics
+        shell: bash
+        run: ccache --show-stats 2>/dev/null || sccache --show-stats
 
   coverage:
     runs-on: ubuntu-latest
     steps:
       - uses: actions/checkout@v4
 
-      - name: Install lcov
-        run: sudo apt-get install -y lcov
+      - name: Install Ninja and lcov
+        run: sudo apt-get update && sudo apt-get install -y ninja-build lcov
 
       - name: Configure with coverage
-        run: cmake -B build -DCMAKE_BUILD_TYPE=Debug -DCODE_COVERAGE=ON -DBUILD_TESTING=ON
+        run: cmake -B build -G Ninja -DCMAKE_BUILD_TYPE=Debug -DCODE_COVERAGE=ON -DBUILD_TESTING=ON
 
       - name: Build
         run: cmake --build build
 
       - name: Run tests
-        run: ctest --test-dir build --output-on-failure
+        run: ctest --test-dir build --output-on-failure -j 4
 
       - name: Collect coverage
         run: |
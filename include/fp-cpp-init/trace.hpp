@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "fp-cpp-init/result.hpp"
+
+namespace fp::trace {
+
+// 开启 / 关闭事件记录（默认关闭；关闭时 Span 只做一次原子读取）
+// 关闭不会清空已记录的事件，需要时再调用 reset()
+auto enable() -> void;
+auto disable() -> void;
+auto is_enabled() -> bool;
+
+// 清空所有线程缓冲区中的事件
+auto reset() -> void;
+
+// RAII 区间：构造时记录开始时间，析构时写入当前线程的缓冲区
+// category 与 name 必须是静态字符串，detail 会被复制
+class Span {
+  public:
+    Span(std::string_view category, std::string_view name, std::string_view detail = {});
+    ~Span();
+
+    Span(const Span&) = delete;
+    auto operator=(const Span&) -> Span& = delete;
+
+  private:
+    bool active_;
+    std::string_view category_;
+    std::string_view name_;
+    std::string detail_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// 纯函数风格：将已缓冲的事件序列化为 Chrome trace-event JSON
+// 应在所有工作线程结束后调用
+auto to_json() -> std::string;
+
+// 副作用：写入 trace 文件（可用 chrome://tracing 或 Perfetto 打开）
+// 创建或写入失败（如磁盘已满）时返回错误
+auto write_json(const std::filesystem::path& path) -> Result<void>;
+
+} // namespace fp::trace
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "fp-cpp-init/result.hpp"
+
+namespace fp {
+
+namespace detail {
+
+template <typename R>
+using result_of_range = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+// 以右值传入的容器（非 view）可以安全地移出元素
+template <typename R>
+inline constexpr bool owns_elements_v =
+    !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>;
+
+template <typename R, typename Elem>
+constexpr auto forward_element(Elem& elem) -> decltype(auto) {
+    if constexpr (owns_elements_v<R>) {
+        return std::move(elem);
+    } else {
+        return std::forward<std::ranges::range_reference_t<R>>(elem);
+    }
+}
+
+// 能预先知道长度时只分配一次
+template <typename R, typename U>
+auto reserve_for(R& range, std::vector<U>& out) -> void {
+    if constexpr (std::ranges::sized_range<R>) {
+        out.reserve(std::ranges::size(range));
+    }
+}
+
+} // namespace detail
+
+// collect: [Result<T, E>] -> Result<std::vector<T>, E>
+// 遇到第一个错误立即返回；Result<void> 序列收集为 Result<void, E>
+// 以右值传入的容器，其中的值和错误都会被移出而不是复制
+template <std::ranges::input_range R>
+auto collect(R&& results) {
+    using In = detail::result_of_range<R>;
+    using T = typename In::value_type;
+    using E = typename In::error_type;
+    using Backend = typename In::backend_type;
+
+    if constexpr (std::is_void_v<T>) {
+        for (auto&& r : results) {
+            if (r.is_err()) {
+                return In(detail::forward_element<R>(r));
+            }
+        }
+        return Result<void, E, Backend>::ok();
+    } else {
+        using Out = Result<std::vector<T>, E, Backend>;
+        std::vector<T> values;
+        detail::reserve_for(results, values);
+        for (auto&& r : results) {
+            if (r.is_err()) {
+                return Out::err(detail::forward_element<R>(r).error());
+            }
+            values.push_back(detail::forward_element<R>(r).value());
+        }
+        return Out::ok(std::move(values));
+    }
+}
+
+// traverse: 对每个元素调用返回 Result 的 f，收集成功值；遇到第一个错误立即返回
+template <std::ranges::input_range R, typename F>
+auto traverse(R&& range, F&& f) {
+    using In = std::invoke_result_t<F&, std::ranges::range_reference_t<R>>;
+    using U = typename In::value_type;
+    using E = typename In::error_type;
+    using Backend = typename In::backend_type;
+
+    if constexpr (std::is_void_v<U>) {
+        for (auto&& elem : range) {
+            auto r = std::invoke(f, detail::forward_element<R>(elem));
+            if (r.is_err()) {
+                return r;
+            }
+        }
+        return Result<void, E, Backend>::ok();
+    } else {
+        using Out = Result<std::vector<U>, E, Backend>;
+        std::vector<U> values;
+        detail::reserve_for(range, values);
+        for (auto&& elem : range) {
+            auto r = std::invoke(f, detail::forward_element<R>(elem));
+            if (r.is_err()) {
+                return Out::err(std::move(r).error());
+            }
+            values.push_back(std::move(r).value());
+        }
+        return Out::ok(std::move(values));
+    }
+}
+
+// parallel_traverse 默认在元素少于此数时直接在当前线程顺序执行
+inline constexpr size_t parallel_traverse_min_size = 32;
+
+// parallel_traverse: 在线程池上并发调用 f（f 必须线程安全）
+// 返回输入顺序上的第一个错误；该错误之后尚未开始的元素会被跳过
+// f 抛出的异常在所有线程结束后重新抛出（取输入顺序上最靠前的一个）
+// max_threads 为 0 时使用硬件并发数；元素少于 min_size 或只有一个线程时退化为 traverse
+template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R>
+auto parallel_traverse(R&& range, F&& f, unsigned max_threads = 0,
+                       size_t min_size = parallel_traverse_min_size) {
+    using In = std::invoke_result_t<F&, std::ranges::range_reference_t<R>>;
+    using U = typename In::value_type;
+    using E = typename In::error_type;
+    using Backend = typename In::backend_type;
+
+    const size_t n = std::ranges::size(range);
+    unsigned hw = max_threads != 0 ? max_threads : std::thread::hardware_concurrency();
+    auto thread_count = static_cast<unsigned>(std::min<size_t>(std::max(1U, hw), n));
+    if (n < min_size || thread_count <= 1) {
+        return traverse(range, f);
+    }
+
+    std::vector<std::optional<In>> slots(n);
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> first_error{n};
+
+    // 异常不能逃出线程（否则 std::terminate），记录下来在 join 之后重新抛出
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+    size_t exception_index = n;
+
+    auto mark_error = [&first_error](size_t i) {
+        size_t current = first_error.load(std::memory_order_relaxed);
+        while (i < current && !first_error.compare_exchange_weak(current, i)) {
+        }
+    };
+
+    auto worker = [&] {
+        for (size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+            if (i > first_error.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            auto&& elem = std::ranges::begin(range)[static_cast<std::ptrdiff_t>(i)];
+            auto& slot = slots[i];
+            try {
+                slot.emplace(std::invoke(f, elem));
+            } catch (...) {
+                std::lock_guard lock(exception_mutex);
+                if (i < exception_index) {
+                    exception = std::current_exception();
+                    exception_index = i;
+                }
+            }
+            if (!slot || slot->is_err()) {
+                mark_error(i);
+            }
+        }
+    };
+
+    // 当前线程也参与工作；jthread 析构时 join，即使后续代码抛出也不会 std::terminate
+    std::vector<std::jthread> pool;
+    pool.reserve(thread_count > 0 ? thread_count - 1 : 0);
+    for (unsigned t = 1; t < thread_count; ++t) {
+        try {
+            pool.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break; // 无法再创建线程：由已启动的线程完成剩余元素
+        }
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    size_t err_index = first_error.load();
+    if (err_index < n && !slots[err_index]) {
+        std::rethrow_exception(exception);
+    }
+    if constexpr (std::is_void_v<U>) {
+        if (err_index < n) {
+            return std::move(*slots[err_index]);
+        }
+        return Result<void, E, Backend>::ok();
+    } else {
+        using Out = Result<std::vector<U>, E, Backend>;
+        if (err_index < n) {
+            return Out::err(std::move(*slots[err_index]).error());
+        }
+        std::vector<U> values;
+        values.reserve(n);
+        for (auto& slot : slots) {
+            values.push_back(std::move(*slot).value());
+        }
+        return Out::ok(std::move(values));
+    }
+}
+
+} // namespace fp
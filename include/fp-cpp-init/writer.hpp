@@ -0,0 +1,15 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+#include "fp-cpp-init/project.hpp"
+#include "fp-cpp-init/result.hpp"
+
+namespace fp {
+
+// 副作用：将项目结构写入 root 目录下，返回已写入的文件路径
+auto write_project(const ProjectFiles& project, const std::filesystem::path& root = {})
+    -> Result<std::vector<std::filesystem::path>>;
+
+} // namespace fp
@@ -1,71 +1,258 @@
 #include "fp-cpp-init/cli.hpp"
 
-#include <cstring>
-#include <sstream>
+#include <algorithm>
+#include <span>
 
+#include "fp-cpp-init/cli_options.hpp"
 #include "fp-cpp-init/platform.hpp"
 
 namespace fp {
 
 namespace {
 
-auto starts_with(const char* str, const char* prefix) -> bool {
-    return strncmp(str, prefix, strlen(prefix)) == 0;
-}
+using cli::OptionId;
+using cli::OptionKind;
+using cli::OptionSpec;
 
-auto get_option_value(const char* arg, const char* long_opt, const char* short_opt) -> std::string {
-    size_t long_len = strlen(long_opt);
-    size_t short_len = strlen(short_opt);
+// 帮助文本中选项说明的起始列
+constexpr size_t help_column = 28;
 
-    if (starts_with(arg, long_opt) && arg[long_len] == '=') {
-        return arg + long_len + 1;
+// "a, b, c" -> "a, b, or c"
+auto must_be_list(std::string_view values) -> std::string {
+    auto last = values.rfind(", ");
+    if (last == std::string_view::npos) {
+        return std::string(values);
     }
-    if (starts_with(arg, short_opt) && arg[short_len] == '=') {
-        return arg + short_len + 1;
+    return std::string(values.substr(0, last + 2)) + "or " + std::string(values.substr(last + 2));
+}
+
+auto invalid_value_error(const OptionSpec& spec, std::string_view value) -> std::string {
+    return "Error: Invalid " + std::string(spec.label) + " '" + std::string(value) +
+           "'. Must be: " + must_be_list(spec.values);
+}
+
+auto unknown_option_error(std::string_view arg) -> std::string {
+    return "Error: Unknown option '" + std::string(arg) + "'";
+}
+
+// 读取 Options 中某个取值选项对应的字段
+auto option_value(const Options& opts, OptionId id) -> std::string_view {
+    switch (id) {
+    case OptionId::Type:
+        return opts.type;
+    case OptionId::License:
+        return opts.license;
+    case OptionId::Std:
+        return opts.cpp_std;
+    case OptionId::Author:
+        return opts.author;
+    case OptionId::Desc:
+        return opts.description;
+    case OptionId::Trace:
+        return opts.trace_path;
+    case OptionId::Socket:
+        return opts.socket_path;
+    case OptionId::Root:
+        return opts.root_path;
+    case OptionId::NoCi:
+    case OptionId::NoLint:
+    case OptionId::Bench:
+    case OptionId::Pgo:
+    case OptionId::Lto:
+    case OptionId::FastBuild:
+    case OptionId::Profiling:
+    case OptionId::AllocTracking:
+    case OptionId::PerfCounters:
+        break;
     }
-    return "";
+    return {};
 }
 
-auto is_valid_type(const std::string& type) -> bool {
-    return type == "exe" || type == "lib" || type == "header";
+// 将一个已校验的选项写入 Options
+auto apply_option(Options& opts, OptionId id, std::string_view value) -> void {
+    switch (id) {
+    case OptionId::Type:
+        opts.type = value;
+        break;
+    case OptionId::License:
+        opts.license = value;
+        break;
+    case OptionId::Std:
+        opts.cpp_std = value;
+        break;
+    case OptionId::Author:
+        opts.author = value;
+        break;
+    case OptionId::Desc:
+        opts.description = value;
+        break;
+    case OptionId::Trace:
+        opts.trace_path = value;
+        break;
+    case OptionId::NoCi:
+        opts.enable_ci = false;
+        break;
+    case OptionId::NoLint:
+        opts.enable_lint = false;
+        break;
+    case OptionId::Bench:
+        opts.enable_bench = true;
+        break;
+    case OptionId::Pgo:
+        opts.enable_pgo = true;
+        break;
+    case OptionId::Lto:
+        opts.enable_lto = true;
+        break;
+    case OptionId::FastBuild:
+        opts.enable_fast_build = true;
+        break;
+    case OptionId::Profiling:
+        opts.enable_profiling = true;
+        break;
+    case OptionId::AllocTracking:
+        opts.enable_alloc_tracking = true;
+        break;
+    case OptionId::PerfCounters:
+        opts.enable_perf_counters = true;
+        break;
+    case OptionId::Socket:
+        opts.socket_path = value;
+        break;
+    case OptionId::Root:
+        opts.root_path = value;
+        break;
+    }
 }
 
-auto is_valid_license(const std::string& license) -> bool {
-    return license == "mit" || license == "apache2" || license == "gpl3" || license == "bsd3" ||
-           license == "none";
+// 按选项表解析 argv[first, argc)，支持 --opt=value 与 --opt value
+auto parse_options(std::span<const OptionSpec> table,
+                   int first,
+                   int argc,
+                   char* argv[],
+                   Options& opts) -> Result<void> {
+    for (int i = first; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto eq = arg.find('=');
+        auto name = arg.substr(0, eq);
+
+        const auto* spec = cli::find_option(table, name);
+        if (spec == nullptr) {
+            return Result<void>::err(unknown_option_error(arg));
+        }
+
+        if (spec->kind == OptionKind::Flag) {
+            if (eq != std::string_view::npos) {
+                return Result<void>::err(unknown_option_error(arg));
+            }
+            apply_option(opts, spec->id, {});
+            continue;
+        }
+
+        std::string_view value;
+        if (eq != std::string_view::npos) {
+            value = arg.substr(eq + 1);
+            // --opt= 视为未知选项（与旧解析器行为一致）
+            if (value.empty()) {
+                return Result<void>::err(unknown_option_error(arg));
+            }
+        } else if (i + 1 < argc && argv[i + 1][0] != '-') {
+            // 下一个参数是选项时不当作值（--author --no-ci 应报缺少值）
+            value = argv[++i];
+        } else {
+            return Result<void>::err("Error: Option '" + std::string(name) +
+                                     "' requires a value");
+        }
+
+        if (cli::check_value(*spec, value).is_err()) {
+            return Result<void>::err(invalid_value_error(*spec, value));
+        }
+        apply_option(opts, spec->id, value);
+    }
+    return Result<void>::ok();
 }
 
-auto is_valid_std(const std::string& std) -> bool {
-    return std == "17" || std == "20" || std == "23";
+// 由选项表生成 OPTIONS 段
+auto append_options_help(std::string& out, std::span<const OptionSpec> table) -> void {
+    const OptionSpec* prev = nullptr;
+    for (const auto& spec : table) {
+        if (prev != nullptr && prev->kind != spec.kind) {
+            out += "\n";
+        }
+        prev = &spec;
+
+        std::string left = "    ";
+        if (!spec.short_name.empty()) {
+            left += spec.short_name;
+            left += ", ";
+        }
+        left += spec.long_name;
+        if (spec.kind == OptionKind::Value) {
+            left += "=<";
+            left += spec.metavar;
+            left += ">";
+        }
+        left.resize(std::max(left.size() + 1, help_column), ' ');
+
+        out += left;
+        out += spec.help;
+        out += "\n";
+        if (!spec.values.empty()) {
+            out += std::string(help_column, ' ');
+            out += "Values: ";
+            out += spec.values;
+            out += "\n";
+        }
+    }
 }
 
 } // anonymous namespace
 
+auto validate_options(const Options& opts) -> Result<Options> {
+    for (const auto& spec : cli::new_options) {
+        auto value = option_value(opts, spec.id);
+        if (spec.kind == OptionKind::Value && cli::check_value(spec, value).is_err()) {
+            return Result<Options>::err(invalid_value_error(spec, value));
+        }
+    }
+    return Result<Options>::ok(opts);
+}
+
 auto parse_args(int argc, char* argv[]) -> Result<Options> {
     Options opts{.command = Command::Help,
                  .project_name = "",
                  .type = "exe",
                  .license = "mit",
                  .cpp_std = "20",
-                 .author = platform::get_git_username().value_or(""),
+                 .author = "",
                  .description = "",
                  .enable_ci = true,
-                 .enable_lint = true};
+                 .enable_lint = true,
+                 .enable_bench = false,
+                 .enable_pgo = false,
+                 .enable_lto = false,
+                 .enable_fast_build = false,
+                 .enable_profiling = false,
+                 .enable_alloc_tracking = false,
+                 .enable_perf_counters = false,
+                 .trace_path = "",
+                 .socket_path = "",
+                 .root_path = ""};
 
     if (argc < 2) {
-        return Result<Options>::ok(opts);
+        return Result<Options>::ok(std::move(opts));
     }
 
-    std::string first_arg = argv[1];
+    std::string_view first_arg = argv[1];
 
     // 全局选项
     if (first_arg == "--help" || first_arg == "-h") {
         opts.command = Command::Help;
-        return Result<Options>::ok(opts);
+        return Result<Options>::ok(std::move(opts));
     }
     if (first_arg == "--version" || first_arg == "-v") {
         opts.command = Command::Version;
-        return Result<Options>::ok(opts);
+        return Result<Options>::ok(std::move(opts));
     }
 
     // new 命令
@@ -77,11 +264,11 @@ auto parse_args(int argc, char* argv[]) -> Result<Options> {
                                         "Usage: fp-cpp-init new <project-name> [options]");
         }
 
-        std::string second_arg = argv[2];
+        std::string_view second_arg = argv[2];
 
         if (second_arg == "--help" || second_arg == "-h") {
             opts.command = Command::NewHelp;
-            return Result<Options>::ok(opts);
+            return Result<Options>::ok(std::move(opts));
         }
 
         if (second_arg[0] == '-') {
@@ -91,46 +278,38 @@ auto parse_args(int argc, char* argv[]) -> Result<Options> {
         opts.project_name = second_arg;
 
         // 解析剩余选项
-        for (int i = 3; i < argc; ++i) {
-            const char* arg = argv[i];
-            std::string val;
-
-            if ((val = get_option_value(arg, "--type", "-t")) != "") {
-                if (!is_valid_type(val)) {
-                    return Result<Options>::err("Error: Invalid type '" + val +
-                                                "'. Must be: exe, lib, or header");
-                }
-                opts.type = val;
-            } else if ((val = get_option_value(arg, "--license", "-l")) != "") {
-                if (!is_valid_license(val)) {
-                    return Result<Options>::err("Error: Invalid license '" + val +
-                                                "'. Must be: mit, apache2, gpl3, bsd3, or none");
-                }
-                opts.license = val;
-            } else if ((val = get_option_value(arg, "--std", "-s")) != "") {
-                if (!is_valid_std(val)) {
-                    return Result<Options>::err("Error: Invalid C++ standard '" + val +
-                                                "'. Must be: 17, 20, or 23");
-                }
-                opts.cpp_std = val;
-            } else if ((val = get_option_value(arg, "--author", "-a")) != "") {
-                opts.author = val;
-            } else if ((val = get_option_value(arg, "--desc", "-d")) != "") {
-                opts.description = val;
-            } else if (strcmp(arg, "--no-ci") == 0) {
-                opts.enable_ci = false;
-            } else if (strcmp(arg, "--no-lint") == 0) {
-                opts.enable_lint = false;
-            } else {
-                return Result<Options>::err("Error: Unknown option '" + std::string(arg) + "'");
-            }
+        auto parsed = parse_options(cli::new_options, 3, argc, argv, opts);
+        if (parsed.is_err()) {
+            return Result<Options>::err(parsed.error());
         }
 
-        return Result<Options>::ok(opts);
+        // 未给出 --author 时才查询 git 配置（需要启动子进程）
+        if (opts.author.empty()) {
+            opts.author = platform::get_git_username().value_or("");
+        }
+
+        return Result<Options>::ok(std::move(opts));
+    }
+
+    // serve 命令
+    if (first_arg == "serve") {
+        opts.command = Command::Serve;
+
+        auto parsed = parse_options(cli::serve_options, 2, argc, argv, opts);
+        if (parsed.is_err()) {
+            return Result<Options>::err(parsed.error());
+        }
+
+        if (opts.socket_path.empty()) {
+            return Result<Options>::err("Error: Socket path required.\n"
+                                        "Usage: fp-cpp-init serve --socket=<PATH>");
+        }
+
+        return Result<Options>::ok(std::move(opts));
     }
 
     // 未知命令
-    return Result<Options>::err("Error: Unknown command '" + first_arg + "'");
+    return Result<Options>::err("Error: Unknown command '" + std::string(first_arg) + "'");
 }
 
 auto get_help_text() -> std::string {
@@ -141,6 +320,8 @@ USAGE:
 
 COMMANDS:
     new <name>    Create a new C++ project
+    serve         Serve generation requests over a Unix socket
+                  (--socket=<PATH> [--root=<DIR>], newline-delimited JSON)
     --help, -h    Show this help message
     --version, -v Show version information
 
@@ -148,6 +329,7 @@ EXAMPLES:
     fp-cpp-init new myproject
     fp-cpp-init new myproject --type=lib --license=apache2
     fp-cpp-init new --help
+    fp-cpp-init serve --socket=/tmp/fp-cpp-init.sock
 
 For more information about a command, use:
     fp-cpp-init <COMMAND> --help
@@ -155,23 +337,16 @@ For more information about a command, use:
 }
 
 auto get_new_help_text() -> std::string {
-    return R"(fp-cpp-init new - Create a new C++ project
+    std::string text = R"(fp-cpp-init new - Create a new C++ project
 
 USAGE:
     fp-cpp-init new <project-name> [OPTIONS]
 
 OPTIONS:
-    -t, --type=<TYPE>       Project type [default: exe]
-                            Values: exe, lib, header
-    -l, --license=<LICENSE> License type [default: mit]
-                            Values: mit, apache2, gpl3, bsd3, none
-    -s, --std=<STANDARD>    C++ standard [default: 20]
-                            Values: 17, 20, 23
-    -a, --author=<NAME>     Author name [default: git config user.name]
-    -d, --desc=<TEXT>       Project description
-
-    --no-ci                 Disable GitHub Actions CI/CD
-    --no-lint               Disable .clang-format and .clang-tidy
+)";
+    append_options_help(text, cli::new_options);
+    text += R"(
+    Value options accept both --opt=value and --opt value.
 
 PROJECT TYPES:
     exe     Executable application (with main.cpp)
@@ -181,10 +356,12 @@ PROJECT TYPES:
 EXAMPLES:
     fp-cpp-init new myapp
     fp-cpp-init new mylib --type=lib --std=20
+    fp-cpp-init new mylib -t lib -s 23
     fp-cpp-init new myheader --type=header --license=apache2
     fp-cpp-init new myproject --author="John Doe" --desc="My awesome project"
     fp-cpp-init new myapp --no-ci --no-lint
 )";
+    return text;
 }
 
 auto get_version_text() -> std::string {
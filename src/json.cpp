@@ -0,0 +1,247 @@
+#include "fp-cpp-init/json.hpp"
+
+#include <cstdio>
+
+namespace fp::json {
+
+namespace {
+
+class Parser {
+  public:
+    explicit Parser(std::string_view text) : text_(text) {}
+
+    auto parse() -> Result<FlatObject> {
+        FlatObject object;
+
+        skip_ws();
+        if (!consume('{')) {
+            return fail("expected '{'");
+        }
+        skip_ws();
+        if (consume('}')) {
+            return finish(std::move(object));
+        }
+
+        while (true) {
+            skip_ws();
+            std::string key;
+            if (!parse_string(key)) {
+                return fail("expected string key");
+            }
+            skip_ws();
+            if (!consume(':')) {
+                return fail("expected ':'");
+            }
+            skip_ws();
+
+            Value value;
+            if (peek() == '"') {
+                std::string str;
+                if (!parse_string(str)) {
+                    return fail("invalid string value");
+                }
+                value = std::move(str);
+            } else if (consume_word("true")) {
+                value = true;
+            } else if (consume_word("false")) {
+                value = false;
+            } else if (peek() == '-' || (peek() >= '0' && peek() <= '9')) {
+                value = parse_number();
+            } else {
+                return fail("unsupported value for key '" + key + "'");
+            }
+            object.insert_or_assign(std::move(key), std::move(value));
+
+            skip_ws();
+            if (consume('}')) {
+                return finish(std::move(object));
+            }
+            if (!consume(',')) {
+                return fail("expected ',' or '}'");
+            }
+        }
+    }
+
+  private:
+    std::string_view text_;
+    size_t pos_ = 0;
+
+    auto peek() const -> char { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+    auto consume(char c) -> bool {
+        if (peek() == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    auto consume_word(std::string_view word) -> bool {
+        if (text_.substr(pos_, word.size()) == word) {
+            pos_ += word.size();
+            return true;
+        }
+        return false;
+    }
+
+    auto skip_ws() -> void {
+        while (peek() == ' ' || peek() == '\t' || peek() == '\n' || peek() == '\r') {
+            ++pos_;
+        }
+    }
+
+    auto parse_number() -> std::string {
+        size_t start = pos_;
+        while (pos_ < text_.size() && std::string_view("+-.eE0123456789").find(peek()) !=
+                                          std::string_view::npos) {
+            ++pos_;
+        }
+        return std::string(text_.substr(start, pos_ - start));
+    }
+
+    auto parse_hex4(unsigned& code) -> bool {
+        if (pos_ + 4 > text_.size()) {
+            return false;
+        }
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = text_[pos_++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<unsigned>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<unsigned>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<unsigned>(c - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 仅支持基本多文种平面的 \uXXXX（按 UTF-8 输出）
+    static auto append_utf8(std::string& out, unsigned code) -> void {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    auto parse_string(std::string& out) -> bool {
+        if (!consume('"')) {
+            return false;
+        }
+        while (pos_ < text_.size()) {
+            char c = text_[pos_++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                return false;
+            }
+            char esc = text_[pos_++];
+            switch (esc) {
+            case '"':
+            case '\\':
+            case '/':
+                out += esc;
+                break;
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u': {
+                unsigned code = 0;
+                if (!parse_hex4(code)) {
+                    return false;
+                }
+                append_utf8(out, code);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+    auto finish(FlatObject object) -> Result<FlatObject> {
+        skip_ws();
+        if (pos_ != text_.size()) {
+            return fail("unexpected trailing characters");
+        }
+        return Result<FlatObject>::ok(std::move(object));
+    }
+
+    auto fail(const std::string& what) const -> Result<FlatObject> {
+        return Result<FlatObject>::err("Invalid JSON at offset " + std::to_string(pos_) + ": " +
+                                       what);
+    }
+};
+
+} // anonymous namespace
+
+auto append_escaped(std::string& out, std::string_view s) -> void {
+    for (char c : s) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            } else {
+                out += c;
+            }
+        }
+    }
+}
+
+auto quote(std::string_view s) -> std::string {
+    std::string out = "\"";
+    append_escaped(out, s);
+    out += '"';
+    return out;
+}
+
+auto parse_flat_object(std::string_view text) -> Result<FlatObject> {
+    return Parser(text).parse();
+}
+
+} // namespace fp::json
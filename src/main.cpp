@@ -1,48 +1,27 @@
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 
 #include "fp-cpp-init/cli.hpp"
 #include "fp-cpp-init/platform.hpp"
 #include "fp-cpp-init/project.hpp"
 #include "fp-cpp-init/render.hpp"
+#include "fp-cpp-init/serve.hpp"
+#include "fp-cpp-init/trace.hpp"
+#include "fp-cpp-init/writer.hpp"
 
 namespace fs = std::filesystem;
 
 namespace {
 
-// 副作用：写入项目文件到磁盘
-auto write_project(const fp::ProjectFiles& project) -> fp::Result<void> {
-    // 创建目录
-    for (const auto& dir : project.directories) {
-        try {
-            fs::create_directories(dir);
-        } catch (const std::exception& e) {
-            return fp::Result<void>::err("Error creating directory: " + std::string(e.what()));
-        }
+// 副作用：退出前一次性序列化 trace 缓冲区
+auto finish_trace(const fp::Options& opts) -> void {
+    if (opts.trace_path.empty()) {
+        return;
     }
-
-    // 写入文件
-    for (const auto& file : project.files) {
-        try {
-            // 确保父目录存在
-            if (file.path.has_parent_path()) {
-                fs::create_directories(file.path.parent_path());
-            }
-
-            std::ofstream ofs(file.path);
-            if (!ofs) {
-                return fp::Result<void>::err("Error creating file: " + file.path.string());
-            }
-            ofs << file.content;
-
-            fp::platform::print_success("Created: " + file.path.string());
-        } catch (const std::exception& e) {
-            return fp::Result<void>::err("Error writing file: " + std::string(e.what()));
-        }
+    auto result = fp::trace::write_json(opts.trace_path);
+    if (result.is_err()) {
+        fp::platform::print_error(result.error());
     }
-
-    return fp::Result<void>::ok();
 }
 
 // 副作用：打印下一步提示
@@ -57,6 +36,23 @@ auto print_next_steps(const fp::Options& opts) -> void {
     } else if (opts.type == "header") {
         std::cout << "  ./build/examples/example\n";
     }
+
+    if (opts.enable_bench) {
+        std::cout << "\nBenchmarks (configure with -DCMAKE_BUILD_TYPE=Release):\n";
+        std::cout << "  cmake --build build --target bench\n";
+    }
+
+    if (opts.enable_pgo) {
+        std::cout << "\nProfile-guided optimization (see cmake/pgo.cmake):\n";
+        std::cout << "  cmake -B build -DCMAKE_BUILD_TYPE=Release -DPGO_MODE=GENERATE\n";
+        std::cout << "  cmake --build build --target pgo-train\n";
+        std::cout << "  cmake -B build -DPGO_MODE=USE && cmake --build build\n";
+    }
+
+    if (opts.enable_profiling) {
+        std::cout << "\nProfiling (Linux, reports in build/profiles/):\n";
+        std::cout << "  cmake --build build --target profile-perf\n";
+    }
 }
 
 } // anonymous namespace
@@ -89,6 +85,17 @@ int main(int argc, char* argv[]) {
         std::cout << fp::get_version_text();
         return 0;
 
+    case fp::Command::Serve: {
+        std::cout << "Listening on " << opts.socket_path << " (Ctrl+C to stop)" << std::endl;
+
+        auto serve_result = fp::serve::run(opts.socket_path, opts.root_path);
+        if (serve_result.is_err()) {
+            fp::platform::print_error(serve_result.error());
+            return 1;
+        }
+        return 0;
+    }
+
     case fp::Command::New: {
         // 检查目录是否已存在
         if (fs::exists(opts.project_name)) {
@@ -96,27 +103,34 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
+        if (!opts.trace_path.empty()) {
+            fp::trace::enable();
+        }
+
         std::cout << "Creating project '" << opts.project_name << "'...\n\n";
 
         // 构建渲染上下文（纯数据）
-        fp::RenderContext ctx{.project_name = opts.project_name,
-                              .description = opts.description,
-                              .cpp_std = opts.cpp_std,
-                              .author = opts.author,
-                              .year = fp::platform::get_current_year(),
-                              .license_name = fp::get_license_display_name(opts.license)};
+        auto ctx = fp::make_render_context(opts, fp::platform::get_current_year());
 
         // 生成项目结构（纯函数）
-        auto project = fp::generate_project(opts, ctx);
+        auto project = [&] {
+            fp::trace::Span span("generate", "generate_project", opts.type);
+            return fp::generate_project(opts, ctx);
+        }();
 
         // 写入文件（副作用）
         auto write_result = write_project(project);
+        finish_trace(opts);
 
         if (write_result.is_err()) {
             fp::platform::print_error(write_result.error());
             return 1;
         }
 
+        for (const auto& path : write_result.value()) {
+            fp::platform::print_success("Created: " + path.string());
+        }
+
         fp::platform::print_success("Project created successfully!");
         print_next_steps(opts);
 
@@ -1,5 +1,7 @@
 #include "fp-cpp-init/project.hpp"
 
+#include <string_view>
+
 #include "fp-cpp-init/render.hpp"
 #include "fp-cpp-init/templates.hpp"
 
@@ -16,6 +18,10 @@ auto add_common_files(ProjectFiles& project, const Options& opts, const RenderCo
     // .gitignore
     project.files.push_back({opts.project_name + "/.gitignore", std::string(templates::gitignore)});
 
+    // CMakePresets.json (debug / release / 性能分析等构建配置)
+    project.files.push_back(
+        {opts.project_name + "/CMakePresets.json", std::string(templates::cmake_presets)});
+
     // .clang-format / .clang-tidy (可选)
     if (opts.enable_lint) {
         project.files.push_back(
@@ -24,11 +30,14 @@ auto add_common_files(ProjectFiles& project, const Options& opts, const RenderCo
             {opts.project_name + "/.clang-tidy", std::string(templates::clang_tidy)});
     }
 
-    // GitHub Actions CI (可选)
+    // GitHub Actions CI (可选)，启用 --bench 时追加基准回归检查 job
     if (opts.enable_ci) {
         project.directories.push_back(opts.project_name + "/.github/workflows");
-        project.files.push_back(
-            {opts.project_name + "/.github/workflows/ci.yml", std::string(templates::github_ci)});
+        std::string ci(templates::github_ci);
+        if (opts.enable_bench) {
+            ci += render(templates::github_ci_bench_job, ctx);
+        }
+        project.files.push_back({opts.project_name + "/.github/workflows/ci.yml", std::move(ci)});
     }
 
     // LICENSE
@@ -50,6 +59,139 @@ auto add_common_files(ProjectFiles& project, const Options& opts, const RenderCo
     }
 }
 
+// 顶层 CMakeLists.txt：基础模板 + 按选项插入/追加的段落
+// 影响编译选项的模块须在任何 target 之前 include，插入到公共锚点之后
+auto render_root_cmake(const char* tmpl, const Options& opts, const RenderContext& ctx)
+    -> std::string {
+    auto content = render(tmpl, ctx);
+
+    std::string early = templates::cmake_dev_tools;
+    if (opts.enable_pgo) {
+        early += templates::cmake_pgo_include;
+    }
+    if (opts.enable_lto) {
+        early += templates::cmake_lto_include;
+    }
+    if (opts.enable_profiling) {
+        early += templates::cmake_profiling_include;
+    }
+    constexpr std::string_view anchor = "set(CMAKE_EXPORT_COMPILE_COMMANDS ON)\n";
+    auto pos = content.find(anchor);
+    content.insert(pos == std::string::npos ? content.size() : pos + anchor.size(), early);
+
+    // exe + --bench：main.cpp 以外的源文件编成 <name>_core，供程序与基准共同链接
+    constexpr std::string_view exe_sources =
+        "file(GLOB_RECURSE SOURCES \"src/*.cpp\")\nadd_executable(${PROJECT_NAME} ${SOURCES})\n";
+    pos = content.find(exe_sources);
+    if (opts.enable_bench && pos != std::string::npos) {
+        content.replace(pos, exe_sources.size(), render(templates::cmake_exe_core, ctx));
+    }
+
+    if (opts.enable_bench) {
+        content += templates::cmake_bench_option;
+    }
+    // 须在所有 target（含 bench/）定义之后
+    if (opts.enable_lto) {
+        content += render(templates::cmake_lto_targets, ctx);
+    }
+    if (opts.enable_fast_build) {
+        content += render(templates::cmake_fast_build_targets, ctx);
+    }
+    if (opts.enable_alloc_tracking) {
+        content += render(templates::cmake_alloc_tracking_targets, ctx);
+    }
+    if (opts.enable_perf_counters) {
+        content += render(templates::cmake_perf_counters_targets, ctx);
+    }
+    return content;
+}
+
+// tests/test_main.cpp：--alloc-tracking 时插入 AllocationGuard 用例（须在 main 之前）
+auto render_test_main(const Options& opts, const RenderContext& ctx) -> std::string {
+    auto content = render(templates::test_main_cpp, ctx);
+    if (!opts.enable_alloc_tracking) {
+        return content;
+    }
+
+    constexpr std::string_view include_anchor = "#include \"test.hpp\"\n";
+    auto pos = content.find(include_anchor);
+    if (pos != std::string::npos) {
+        content.insert(pos + include_anchor.size(), templates::test_alloc_tracking_include);
+    }
+    constexpr std::string_view main_anchor = "// Usage: tests";
+    pos = content.find(main_anchor);
+    content.insert(pos == std::string::npos ? content.size() : pos,
+                   render(templates::test_alloc_tracking_cases, ctx));
+    return content;
+}
+
+// bench/ 目录（--bench）
+auto add_bench_files(ProjectFiles& project, const Options& opts, const RenderContext& ctx)
+    -> void {
+    project.directories.push_back(opts.project_name + "/bench");
+
+    // exe 的函数移到 src/<name>.cpp（<name>_core 库），main.cpp 只保留 main，
+    // 另生成声明头文件供程序与基准共用
+    const bool is_exe = opts.type != "lib" && opts.type != "header";
+    if (is_exe) {
+        project.files.push_back(
+            {opts.project_name + "/include/" + opts.project_name + "/" + opts.project_name + ".hpp",
+             render(templates::lib_hpp, ctx)});
+        project.files.push_back({opts.project_name + "/src/" + opts.project_name + ".cpp",
+                                 render(templates::lib_cpp, ctx)});
+    }
+
+    project.files.push_back(
+        {opts.project_name + "/bench/CMakeLists.txt",
+         render(is_exe ? templates::cmake_bench_exe : templates::cmake_bench, ctx) +
+             render(templates::cmake_bench_compare, ctx)});
+    project.files.push_back({opts.project_name + "/bench/compare.cmake",
+                             std::string(templates::bench_compare_cmake)});
+    project.files.push_back(
+        {opts.project_name + "/bench/bench.hpp", render(templates::bench_hpp, ctx)});
+    project.files.push_back(
+        {opts.project_name + "/bench/bench_main.cpp", render(templates::bench_main_cpp, ctx)});
+}
+
+// cmake/pgo.cmake 与 cmake/pgo_merge.cmake（--pgo）
+auto add_pgo_files(ProjectFiles& project, const Options& opts, const RenderContext& ctx)
+    -> void {
+    project.files.push_back(
+        {opts.project_name + "/cmake/pgo.cmake", render(templates::cmake_pgo, ctx)});
+    project.files.push_back(
+        {opts.project_name + "/cmake/pgo_merge.cmake", std::string(templates::cmake_pgo_merge)});
+}
+
+// cmake/fast_build.cmake 与 pch/pch.hpp（--fast-build）
+auto add_fast_build_files(ProjectFiles& project, const Options& opts) -> void {
+    project.directories.push_back(opts.project_name + "/pch");
+    project.files.push_back({opts.project_name + "/cmake/fast_build.cmake",
+                             std::string(templates::cmake_fast_build)});
+    project.files.push_back({opts.project_name + "/pch/pch.hpp", std::string(templates::pch_hpp)});
+}
+
+// cmake/alloc_tracking.cmake 与 alloc/（--alloc-tracking）
+auto add_alloc_tracking_files(ProjectFiles& project, const Options& opts,
+                              const RenderContext& ctx) -> void {
+    project.directories.push_back(opts.project_name + "/alloc");
+    project.files.push_back({opts.project_name + "/cmake/alloc_tracking.cmake",
+                             render(templates::cmake_alloc_tracking, ctx)});
+    project.files.push_back({opts.project_name + "/alloc/alloc_tracking.hpp",
+                             render(templates::alloc_tracking_hpp, ctx)});
+    project.files.push_back({opts.project_name + "/alloc/alloc_tracking.cpp",
+                             render(templates::alloc_tracking_cpp, ctx)});
+}
+
+// cmake/profiling.cmake 与 tools/profile.sh（--profiling）
+auto add_profiling_files(ProjectFiles& project, const Options& opts, const RenderContext& ctx)
+    -> void {
+    project.directories.push_back(opts.project_name + "/tools");
+    project.files.push_back(
+        {opts.project_name + "/cmake/profiling.cmake", render(templates::cmake_profiling, ctx)});
+    project.files.push_back(
+        {opts.project_name + "/tools/profile.sh", std::string(templates::profile_sh)});
+}
+
 auto generate_exe_project(const Options& opts, const RenderContext& ctx) -> ProjectFiles {
     ProjectFiles project;
 
@@ -59,7 +201,8 @@ auto generate_exe_project(const Options& opts, const RenderContext& ctx) -> Proj
 
     // CMakeLists.txt
     project.files.push_back(
-        {opts.project_name + "/CMakeLists.txt", render(templates::cmake_exe, ctx)});
+        {opts.project_name + "/CMakeLists.txt",
+         render_root_cmake(templates::cmake_exe, opts, ctx)});
 
     // GitHub Actions Release (只有 exe 类型且启用 CI 时需要)
     if (opts.enable_ci) {
@@ -71,9 +214,10 @@ auto generate_exe_project(const Options& opts, const RenderContext& ctx) -> Proj
     project.files.push_back({opts.project_name + "/include/" + opts.project_name + "/result.hpp",
                              render(templates::result_hpp, ctx)});
 
-    // src/main.cpp
+    // src/main.cpp（--bench 时函数已在 src/<name>.cpp 中）
     project.files.push_back(
-        {opts.project_name + "/src/main.cpp", render(templates::main_cpp, ctx)});
+        {opts.project_name + "/src/main.cpp",
+         render(opts.enable_bench ? templates::main_core_cpp : templates::main_cpp, ctx)});
 
     // README.md
     project.files.push_back({opts.project_name + "/README.md", render(templates::readme, ctx)});
@@ -90,7 +234,8 @@ auto generate_lib_project(const Options& opts, const RenderContext& ctx) -> Proj
 
     // CMakeLists.txt
     project.files.push_back(
-        {opts.project_name + "/CMakeLists.txt", render(templates::cmake_lib, ctx)});
+        {opts.project_name + "/CMakeLists.txt",
+         render_root_cmake(templates::cmake_lib, opts, ctx)});
 
     // tests/CMakeLists.txt
     project.files.push_back(
@@ -109,9 +254,11 @@ auto generate_lib_project(const Options& opts, const RenderContext& ctx) -> Proj
     project.files.push_back({opts.project_name + "/src/" + opts.project_name + ".cpp",
                              render(templates::lib_cpp, ctx)});
 
-    // tests/test_main.cpp
+    // tests/test_main.cpp 与 tests/test.hpp (常开的 CHECK 测试框架)
     project.files.push_back(
-        {opts.project_name + "/tests/test_main.cpp", render(templates::test_main_cpp, ctx)});
+        {opts.project_name + "/tests/test_main.cpp", render_test_main(opts, ctx)});
+    project.files.push_back(
+        {opts.project_name + "/tests/test.hpp", render(templates::test_hpp, ctx)});
 
     // README.md
     project.files.push_back({opts.project_name + "/README.md", render(templates::readme_lib, ctx)});
@@ -128,7 +275,8 @@ auto generate_header_project(const Options& opts, const RenderContext& ctx) -> P
 
     // CMakeLists.txt
     project.files.push_back(
-        {opts.project_name + "/CMakeLists.txt", render(templates::cmake_header, ctx)});
+        {opts.project_name + "/CMakeLists.txt",
+         render_root_cmake(templates::cmake_header, opts, ctx)});
 
     // examples/CMakeLists.txt
     project.files.push_back(
@@ -147,9 +295,11 @@ auto generate_header_project(const Options& opts, const RenderContext& ctx) -> P
     project.files.push_back(
         {opts.project_name + "/examples/example.cpp", render(templates::example_cpp, ctx)});
 
-    // tests/test_main.cpp
+    // tests/test_main.cpp 与 tests/test.hpp (常开的 CHECK 测试框架)
+    project.files.push_back(
+        {opts.project_name + "/tests/test_main.cpp", render_test_main(opts, ctx)});
     project.files.push_back(
-        {opts.project_name + "/tests/test_main.cpp", render(templates::test_main_cpp, ctx)});
+        {opts.project_name + "/tests/test.hpp", render(templates::test_hpp, ctx)});
 
     // README.md
     project.files.push_back({opts.project_name + "/README.md", render(templates::readme_lib, ctx)});
@@ -159,14 +309,55 @@ auto generate_header_project(const Options& opts, const RenderContext& ctx) -> P
 
 } // anonymous namespace
 
+auto make_render_context(const Options& opts, std::string year) -> RenderContext {
+    return RenderContext{.project_name = opts.project_name,
+                         .description = opts.description,
+                         .cpp_std = opts.cpp_std,
+                         .author = opts.author,
+                         .year = std::move(year),
+                         .license_name = get_license_display_name(opts.license)};
+}
+
 auto generate_project(const Options& opts, const RenderContext& ctx) -> ProjectFiles {
+    ProjectFiles project;
     if (opts.type == "lib") {
-        return generate_lib_project(opts, ctx);
+        project = generate_lib_project(opts, ctx);
+    } else if (opts.type == "header") {
+        project = generate_header_project(opts, ctx);
+    } else {
+        project = generate_exe_project(opts, ctx);
+    }
+
+    if (opts.enable_bench) {
+        add_bench_files(project, opts, ctx);
+    }
+    if (opts.enable_pgo || opts.enable_lto || opts.enable_fast_build || opts.enable_profiling ||
+        opts.enable_alloc_tracking) {
+        project.directories.push_back(opts.project_name + "/cmake");
     }
-    if (opts.type == "header") {
-        return generate_header_project(opts, ctx);
+    if (opts.enable_pgo) {
+        add_pgo_files(project, opts, ctx);
     }
-    return generate_exe_project(opts, ctx);
+    if (opts.enable_lto) {
+        project.files.push_back(
+            {opts.project_name + "/cmake/lto.cmake", std::string(templates::cmake_lto)});
+    }
+    if (opts.enable_fast_build) {
+        add_fast_build_files(project, opts);
+    }
+    if (opts.enable_profiling) {
+        add_profiling_files(project, opts, ctx);
+    }
+    if (opts.enable_alloc_tracking) {
+        add_alloc_tracking_files(project, opts, ctx);
+    }
+    // perf/perf_counters.hpp（--perf-counters），基准与 example 通过 __has_include 使用
+    if (opts.enable_perf_counters) {
+        project.directories.push_back(opts.project_name + "/perf");
+        project.files.push_back({opts.project_name + "/perf/perf_counters.hpp",
+                                 render(templates::perf_counters_hpp, ctx)});
+    }
+    return project;
 }
 
 } // namespace fp
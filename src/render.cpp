@@ -1,8 +1,11 @@
 #include "fp-cpp-init/render.hpp"
 
+#include "fp-cpp-init/trace.hpp"
+
 namespace fp {
 
 auto render(std::string_view tmpl, const RenderContext& ctx) -> std::string {
+    trace::Span span("render", "render");
     std::string result(tmpl);
 
     auto replace_all = [&result](const std::string& from, const std::string& to) {
@@ -0,0 +1,449 @@
+#include "fp-cpp-init/serve.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <sys/time.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#include "fp-cpp-init/json.hpp"
+#include "fp-cpp-init/platform.hpp"
+#include "fp-cpp-init/project.hpp"
+#include "fp-cpp-init/writer.hpp"
+
+namespace fs = std::filesystem;
+
+namespace fp::serve {
+
+namespace {
+
+constexpr size_t max_request_bytes = 64 * 1024;
+
+// 已接受但尚无空闲线程处理的连接上限，超出时直接回复繁忙并关闭
+constexpr size_t max_pending_connections = 64;
+
+// 连接空闲（收不到数据）超过该秒数即关闭，避免占住工作线程
+constexpr time_t idle_timeout_seconds = 30;
+
+auto get_string(const json::FlatObject& obj, std::string_view key, std::string& out)
+    -> Result<void> {
+    auto it = obj.find(key);
+    if (it == obj.end()) {
+        return Result<void>::ok();
+    }
+    if (const auto* str = std::get_if<std::string>(&it->second)) {
+        out = *str;
+        return Result<void>::ok();
+    }
+    return Result<void>::err("Error: Field '" + std::string(key) + "' must be a string");
+}
+
+auto get_bool(const json::FlatObject& obj, std::string_view key, bool& out) -> Result<void> {
+    auto it = obj.find(key);
+    if (it == obj.end()) {
+        return Result<void>::ok();
+    }
+    if (const auto* flag = std::get_if<bool>(&it->second)) {
+        out = *flag;
+        return Result<void>::ok();
+    }
+    return Result<void>::err("Error: Field '" + std::string(key) + "' must be a boolean");
+}
+
+// 项目名会成为目录名，不允许越出输出目录
+auto is_valid_project_name(const std::string& name) -> bool {
+    return !name.empty() && name[0] != '-' && name != "." && name != ".." &&
+           name.find_first_of("/\\") == std::string::npos;
+}
+
+// 纯函数：path 是否位于 root 之下（两者均已规范化，逐段比较）
+auto is_within(const fs::path& path, const fs::path& root) -> bool {
+    auto [root_end, path_it] = std::mismatch(root.begin(), root.end(), path.begin(), path.end());
+    // root 末尾的空段来自结尾的分隔符，可忽略
+    return root_end == root.end() || (std::next(root_end) == root.end() && root_end->empty());
+}
+
+// 将请求的 dir 解析到 root 之下；客户端不可信，dir 不能借绝对路径、".." 或符号链接越出 root
+auto resolve_dir(const fs::path& root, const std::string& dir) -> Result<fs::path> {
+    fs::path relative(dir.empty() ? "." : dir);
+    if (relative.has_root_name() || relative.has_root_directory()) {
+        return Result<fs::path>::err("Error: Field 'dir' must be relative to the server root");
+    }
+    for (const auto& part : relative) {
+        if (part == "..") {
+            return Result<fs::path>::err("Error: Field 'dir' must not contain '..'");
+        }
+    }
+
+    std::error_code ec;
+    auto base = fs::weakly_canonical(root.empty() ? fs::current_path(ec) : root, ec);
+    auto resolved = ec ? fs::path{} : fs::weakly_canonical(base / relative, ec);
+    if (ec) {
+        return Result<fs::path>::err("Error: Cannot resolve dir '" + dir + "': " + ec.message());
+    }
+    if (!is_within(resolved, base)) {
+        return Result<fs::path>::err("Error: Field 'dir' escapes the server root");
+    }
+    return Result<fs::path>::ok(std::move(resolved));
+}
+
+auto error_response(const std::string& error) -> std::string {
+    return "{\"ok\":false,\"error\":" + json::quote(error) + "}";
+}
+
+} // anonymous namespace
+
+auto parse_request(std::string_view line, const Defaults& defaults) -> Result<Request> {
+    auto parsed = json::parse_flat_object(line);
+    if (parsed.is_err()) {
+        return Result<Request>::err("Error: " + parsed.error());
+    }
+    const auto& obj = parsed.value();
+
+    Request req{.opts = {.command = Command::New,
+                         .project_name = "",
+                         .type = "exe",
+                         .license = "mit",
+                         .cpp_std = "20",
+                         .author = defaults.author,
+                         .description = "",
+                         .enable_ci = true,
+                         .enable_lint = true,
+                         .enable_bench = false,
+                         .enable_pgo = false,
+                         .enable_lto = false,
+                         .enable_fast_build = false,
+                         .enable_profiling = false,
+                         .enable_alloc_tracking = false,
+                         .enable_perf_counters = false,
+                         .trace_path = "",
+                         .socket_path = "",
+                         .root_path = ""},
+                .dir = {}};
+
+    std::string dir;
+    for (auto field : {get_string(obj, "name", req.opts.project_name),
+                       get_string(obj, "type", req.opts.type),
+                       get_string(obj, "license", req.opts.license),
+                       get_string(obj, "std", req.opts.cpp_std),
+                       get_string(obj, "author", req.opts.author),
+                       get_string(obj, "desc", req.opts.description),
+                       get_string(obj, "dir", dir), get_bool(obj, "ci", req.opts.enable_ci),
+                       get_bool(obj, "lint", req.opts.enable_lint),
+                       get_bool(obj, "bench", req.opts.enable_bench),
+                       get_bool(obj, "pgo", req.opts.enable_pgo),
+                       get_bool(obj, "lto", req.opts.enable_lto),
+                       get_bool(obj, "fast_build", req.opts.enable_fast_build),
+                       get_bool(obj, "profiling", req.opts.enable_profiling),
+                       get_bool(obj, "alloc_tracking", req.opts.enable_alloc_tracking),
+                       get_bool(obj, "perf_counters", req.opts.enable_perf_counters)}) {
+        if (field.is_err()) {
+            return Result<Request>::err(field.error());
+        }
+    }
+
+    if (!is_valid_project_name(req.opts.project_name)) {
+        return Result<Request>::err("Error: Invalid project name '" + req.opts.project_name +
+                                    "'");
+    }
+    auto resolved = resolve_dir(defaults.root, dir);
+    if (resolved.is_err()) {
+        return Result<Request>::err(resolved.error());
+    }
+    req.dir = std::move(resolved).value();
+
+    auto validated = validate_options(req.opts);
+    if (validated.is_err()) {
+        return Result<Request>::err(validated.error());
+    }
+    return Result<Request>::ok(std::move(req));
+}
+
+auto handle_request(std::string_view line, const Defaults& defaults) -> std::string {
+    auto parsed = parse_request(line, defaults);
+    if (parsed.is_err()) {
+        return error_response(parsed.error());
+    }
+    const auto& req = parsed.value();
+
+    // 原子地占用项目目录，避免并发请求写入同一项目
+    try {
+        fs::create_directories(req.dir);
+        if (!fs::create_directory(req.dir / req.opts.project_name)) {
+            return error_response("Directory '" + (req.dir / req.opts.project_name).string() +
+                                  "' already exists.");
+        }
+    } catch (const std::exception& e) {
+        return error_response("Error creating directory: " + std::string(e.what()));
+    }
+
+    auto ctx = make_render_context(req.opts, defaults.year);
+    auto written = write_project(generate_project(req.opts, ctx), req.dir);
+    if (written.is_err()) {
+        return error_response(written.error());
+    }
+
+    std::string response = "{\"ok\":true,\"files\":[";
+    bool first = true;
+    for (const auto& path : written.value()) {
+        response += first ? "" : ",";
+        response += json::quote(path.string());
+        first = false;
+    }
+    response += "]}";
+    return response;
+}
+
+#ifdef _WIN32
+
+auto run(const std::string& /*socket_path*/, const std::string& /*root_path*/) -> Result<void> {
+    return Result<void>::err(
+        "Error: serve requires Unix domain sockets (not supported on Windows)");
+}
+
+#else
+
+namespace {
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+extern "C" void on_stop_signal(int /*signum*/) {
+    stop_requested = 1;
+}
+
+auto send_all(int fd, std::string_view data) -> bool {
+    while (!data.empty()) {
+        ssize_t n = ::send(fd, data.data(), data.size(), 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+// 每个连接：按行读取请求，逐行回复（不关闭 fd，由 WorkerPool 负责）
+auto serve_connection(int fd, const Defaults& defaults) -> void {
+    std::string buffer;
+    char chunk[4096];
+
+    while (true) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        // 对端关闭、出错或空闲超时（SO_RCVTIMEO）
+        if (n <= 0) {
+            break;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+
+        size_t newline = 0;
+        while ((newline = buffer.find('\n')) != std::string::npos) {
+            std::string_view line(buffer.data(), newline);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            bool sent = line.empty() || send_all(fd, handle_request(line, defaults) + "\n");
+            buffer.erase(0, newline + 1);
+            if (!sent) {
+                return;
+            }
+        }
+
+        if (buffer.size() > max_request_bytes) {
+            send_all(fd, error_response("Error: Request line too long") + "\n");
+            break;
+        }
+    }
+}
+
+// 固定数量的工作线程，从有界队列中取连接处理；析构时关闭队列中和处理中的连接并 join
+class WorkerPool {
+  public:
+    WorkerPool(size_t workers, std::shared_ptr<const Defaults> defaults)
+        : defaults_(std::move(defaults)) {
+        // 工作线程屏蔽 SIGINT/SIGTERM，保证信号打断的是主线程的 accept()
+        sigset_t blocked;
+        sigset_t previous;
+        sigemptyset(&blocked);
+        sigaddset(&blocked, SIGINT);
+        sigaddset(&blocked, SIGTERM);
+        ::pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+        for (size_t i = 0; i < workers; ++i) {
+            threads_.emplace_back([this] { work(); });
+        }
+        ::pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+            for (int fd : pending_) {
+                ::close(fd);
+            }
+            pending_.clear();
+            // 唤醒阻塞在 recv 的连接：正在处理的请求照常完成，之后读到 EOF 退出
+            for (int fd : active_) {
+                ::shutdown(fd, SHUT_RD);
+            }
+        }
+        ready_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    auto operator=(const WorkerPool&) -> WorkerPool& = delete;
+
+    // 队列已满时返回 false，由调用方拒绝该连接
+    auto submit(int fd) -> bool {
+        {
+            std::lock_guard lock(mutex_);
+            if (pending_.size() >= max_pending_connections) {
+                return false;
+            }
+            pending_.push_back(fd);
+        }
+        ready_.notify_one();
+        return true;
+    }
+
+  private:
+    std::shared_ptr<const Defaults> defaults_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<int> pending_;
+    std::vector<int> active_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+
+    auto work() -> void {
+        while (true) {
+            int fd = -1;
+            {
+                std::unique_lock lock(mutex_);
+                ready_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+                if (stopping_) {
+                    return;
+                }
+                fd = pending_.front();
+                pending_.pop_front();
+                active_.push_back(fd);
+            }
+
+            serve_connection(fd, *defaults_);
+
+            // 先移出 active_ 再关闭：析构函数只会 shutdown 仍由本池持有的 fd，
+            // 不会碰到已关闭或被复用的编号
+            {
+                std::lock_guard lock(mutex_);
+                active_.erase(std::find(active_.begin(), active_.end(), fd));
+            }
+            ::close(fd);
+        }
+    }
+};
+
+} // anonymous namespace
+
+auto run(const std::string& socket_path, const std::string& root_path) -> Result<void> {
+    // 输出根目录在启动时固定：规范化一次，之后所有请求都相对它解析
+    std::error_code root_ec;
+    auto root = fs::weakly_canonical(fs::absolute(root_path.empty() ? "." : root_path), root_ec);
+    if (root_ec || !fs::is_directory(root, root_ec)) {
+        return Result<void>::err("Error: Root directory '" + root_path + "' does not exist");
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        return Result<void>::err("Error: Socket path too long: " + socket_path);
+    }
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    // 清理上次遗留的 socket 文件（只删除 socket，不误删普通文件）
+    std::error_code ec;
+    if (fs::is_socket(socket_path, ec)) {
+        fs::remove(socket_path, ec);
+    }
+
+    int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        return Result<void>::err("Error creating socket: " + std::string(std::strerror(errno)));
+    }
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listen_fd, SOMAXCONN) < 0) {
+        auto error = std::string(std::strerror(errno));
+        ::close(listen_fd);
+        return Result<void>::err("Error binding socket '" + socket_path + "': " + error);
+    }
+
+    // 常驻状态：默认值只解析一次，所有连接线程共享（只读）
+    auto defaults = std::make_shared<const Defaults>(
+        Defaults{.author = platform::get_git_username().value_or(""),
+                 .year = platform::get_current_year(),
+                 .root = root});
+
+    // 不设置 SA_RESTART，使 accept() 能被信号打断以便退出；返回前恢复原来的处理函数
+    stop_requested = 0;
+    struct sigaction action {};
+    action.sa_handler = on_stop_signal;
+    sigemptyset(&action.sa_mask);
+    struct sigaction previous_int {};
+    struct sigaction previous_term {};
+    ::sigaction(SIGINT, &action, &previous_int);
+    ::sigaction(SIGTERM, &action, &previous_term);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    {
+        WorkerPool pool(std::max(4U, std::thread::hardware_concurrency()), defaults);
+
+        while (stop_requested == 0) {
+            int client_fd = ::accept(listen_fd, nullptr, nullptr);
+            if (client_fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                break;
+            }
+
+            timeval timeout{.tv_sec = idle_timeout_seconds, .tv_usec = 0};
+            ::setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            if (!pool.submit(client_fd)) {
+                send_all(client_fd, error_response("Error: Server busy, try again later") + "\n");
+                ::close(client_fd);
+            }
+        }
+    } // 停止前 join 所有工作线程
+
+    ::sigaction(SIGINT, &previous_int, nullptr);
+    ::sigaction(SIGTERM, &previous_term, nullptr);
+    ::close(listen_fd);
+    fs::remove(socket_path, ec);
+    return Result<void>::ok();
+}
+
+#endif
+
+} // namespace fp::serve
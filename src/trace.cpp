@@ -0,0 +1,147 @@
+#include "fp-cpp-init/trace.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "fp-cpp-init/json.hpp"
+
+namespace fp::trace {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    std::string_view category;
+    std::string_view name;
+    std::string detail;
+    Clock::time_point start;
+    Clock::time_point end;
+};
+
+// 每个线程独占一个缓冲区，记录时无需加锁
+struct ThreadBuffer {
+    std::uint32_t tid;
+    std::vector<Event> events;
+};
+
+// 缓冲区归注册表所有，线程退出后事件仍然保留到序列化
+struct Registry {
+    std::atomic<bool> enabled{false};
+    Clock::time_point epoch = Clock::now();
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+auto registry() -> Registry& {
+    static Registry instance;
+    return instance;
+}
+
+auto local_buffer() -> ThreadBuffer& {
+    thread_local ThreadBuffer* buffer = [] {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        auto tid = static_cast<std::uint32_t>(reg.buffers.size() + 1);
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>(ThreadBuffer{tid, {}}));
+        return reg.buffers.back().get();
+    }();
+    return *buffer;
+}
+
+// trace-event 的时间单位是微秒，保留纳秒精度
+auto append_micros(std::string& out, Clock::duration d) -> void {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld.%03lld", static_cast<long long>(ns / 1000),
+                  static_cast<long long>(ns % 1000));
+    out += buf;
+}
+
+} // anonymous namespace
+
+auto enable() -> void {
+    registry().enabled.store(true, std::memory_order_relaxed);
+}
+
+auto disable() -> void {
+    registry().enabled.store(false, std::memory_order_relaxed);
+}
+
+auto is_enabled() -> bool {
+    return registry().enabled.load(std::memory_order_relaxed);
+}
+
+auto reset() -> void {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        buffer->events.clear();
+    }
+}
+
+Span::Span(std::string_view category, std::string_view name, std::string_view detail)
+    : active_(is_enabled()), category_(category), name_(name) {
+    if (active_) {
+        detail_ = detail;
+        start_ = Clock::now();
+    }
+}
+
+Span::~Span() {
+    if (active_) {
+        local_buffer().events.push_back(
+            {category_, name_, std::move(detail_), start_, Clock::now()});
+    }
+}
+
+auto to_json() -> std::string {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : reg.buffers) {
+        for (const auto& e : buffer->events) {
+            out += first ? "\n" : ",\n";
+            first = false;
+            out += "{\"name\":\"";
+            json::append_escaped(out, e.name);
+            out += "\",\"cat\":\"";
+            json::append_escaped(out, e.category);
+            out += "\",\"ph\":\"X\",\"ts\":";
+            append_micros(out, e.start - reg.epoch);
+            out += ",\"dur\":";
+            append_micros(out, e.end - e.start);
+            out += ",\"pid\":1,\"tid\":" + std::to_string(buffer->tid);
+            if (!e.detail.empty()) {
+                out += ",\"args\":{\"detail\":\"";
+                json::append_escaped(out, e.detail);
+                out += "\"}";
+            }
+            out += "}";
+        }
+    }
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+auto write_json(const std::filesystem::path& path) -> Result<void> {
+    std::ofstream ofs(path);
+    if (!ofs) {
+        return Result<void>::err("Error creating trace file: " + path.string());
+    }
+    ofs << to_json();
+    ofs.flush();
+    if (!ofs.good()) {
+        return Result<void>::err("Error writing trace file: " + path.string());
+    }
+    return Result<void>::ok();
+}
+
+} // namespace fp::trace
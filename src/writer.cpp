@@ -0,0 +1,59 @@
+#include "fp-cpp-init/writer.hpp"
+
+#include <fstream>
+
+#include "fp-cpp-init/trace.hpp"
+#include "fp-cpp-init/traverse.hpp"
+
+namespace fs = std::filesystem;
+
+namespace fp {
+
+namespace {
+
+auto ensure_directory(const fs::path& root, const fs::path& dir) -> Result<void> {
+    try {
+        trace::Span span("io", "create_directory", dir.string());
+        fs::create_directories(root / dir);
+        return Result<void>::ok();
+    } catch (const std::exception& e) {
+        return Result<void>::err("Error creating directory: " + std::string(e.what()));
+    }
+}
+
+auto write_file(const fs::path& root, const FileEntry& file) -> Result<fs::path> {
+    try {
+        trace::Span span("io", "write_file", file.path.string());
+        auto path = root / file.path;
+
+        // 确保父目录存在
+        if (path.has_parent_path()) {
+            fs::create_directories(path.parent_path());
+        }
+
+        std::ofstream ofs(path);
+        if (!ofs) {
+            return Result<fs::path>::err("Error creating file: " + path.string());
+        }
+        ofs << file.content;
+
+        return Result<fs::path>::ok(std::move(path));
+    } catch (const std::exception& e) {
+        return Result<fs::path>::err("Error writing file: " + std::string(e.what()));
+    }
+}
+
+} // anonymous namespace
+
+auto write_project(const ProjectFiles& project, const fs::path& root)
+    -> Result<std::vector<fs::path>> {
+    // 先创建目录，再写入文件；任一步失败立即返回
+    return traverse(project.directories,
+                    [&root](const fs::path& dir) { return ensure_directory(root, dir); })
+        .and_then([&] {
+            return traverse(project.files,
+                            [&root](const FileEntry& file) { return write_file(root, file); });
+        });
+}
+
+} // namespace fp
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+
+// 分配预算断言：以 -DTEST_ALLOC_COUNTING=ON 配置时，tests 链接计数版 operator new
+// REQUIRE_ALLOCATIONS_AT_MOST(n, expr) 要求求值 expr 期间的堆分配次数不超过 n
+// 未启用计数时该断言跳过当前测试
+
+#if FP_TEST_ALLOC_COUNTING
+
+#include "alloc_counter.hpp"
+
+#define REQUIRE_ALLOCATIONS_AT_MOST(n, expr)                                                       \
+    do {                                                                                           \
+        auto fp_alloc_before_ = ::fp::bench::alloc_snapshot();                                     \
+        static_cast<void>(expr);                                                                   \
+        auto fp_alloc_used_ = ::fp::bench::alloc_snapshot() - fp_alloc_before_;                    \
+        INFO(#expr << ": " << fp_alloc_used_.count << " allocations, " << fp_alloc_used_.bytes     \
+                   << " bytes");                                                                   \
+        REQUIRE(fp_alloc_used_.count <= static_cast<std::uint64_t>(n));                            \
+    } while (false)
+
+#else
+
+#define REQUIRE_ALLOCATIONS_AT_MOST(n, expr)                                                       \
+    SKIP("allocation counting disabled (configure with -DTEST_ALLOC_COUNTING=ON)")
+
+#endif
@@ -0,0 +1,151 @@
+// 规模测试：通过库 API 生成大量混合类型的项目，报告吞吐量与峰值内存
+// 任一指标越过阈值时返回非零；由 ctest -C perf -L perf-scale 运行
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "fp-cpp-init/cli.hpp"
+#include "fp-cpp-init/project.hpp"
+#include "fp-cpp-init/writer.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 纯数据：规模与阈值（命令行 --name=value 覆盖）
+struct Config {
+    size_t projects = 10000;
+    double min_projects_per_sec = 100;
+    double min_files_per_sec = 1000;
+    double max_rss_mb = 512;
+};
+
+auto parse_number(std::string_view text, double& out) -> bool {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+auto parse_config(int argc, char* argv[], Config& config) -> bool {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto eq = arg.find('=');
+        auto name = arg.substr(0, eq);
+        double value = 0;
+        if (eq == std::string_view::npos || !parse_number(arg.substr(eq + 1), value)) {
+            std::fprintf(stderr, "Invalid argument: %s\n", argv[i]);
+            return false;
+        }
+        if (name == "--projects") {
+            config.projects = static_cast<size_t>(value);
+        } else if (name == "--min-projects-per-sec") {
+            config.min_projects_per_sec = value;
+        } else if (name == "--min-files-per-sec") {
+            config.min_files_per_sec = value;
+        } else if (name == "--max-rss-mb") {
+            config.max_rss_mb = value;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// 纯函数：第 i 个项目的选项（类型、许可证、标准与开关轮换组合）
+auto options_for(size_t i) -> fp::Options {
+    constexpr const char* types[] = {"exe", "lib", "header"};
+    constexpr const char* licenses[] = {"mit", "apache2", "gpl3", "bsd3", "none"};
+    constexpr const char* standards[] = {"17", "20", "23"};
+
+    fp::Options opts;
+    opts.command = fp::Command::New;
+    opts.project_name = "p" + std::to_string(i);
+    opts.type = types[i % 3];
+    opts.license = licenses[i % 5];
+    opts.cpp_std = standards[(i / 3) % 3];
+    opts.author = "Scale Test";
+    opts.description = "Project " + std::to_string(i);
+    opts.enable_ci = i % 2 == 0;
+    opts.enable_lint = i % 7 != 0;
+    return opts;
+}
+
+// 副作用：进程峰值常驻内存（MB），不支持的平台返回 0
+auto peak_rss_mb() -> double {
+#ifndef _WIN32
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0); // 字节
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0; // KB
+#endif
+#else
+    return 0;
+#endif
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Config config;
+    if (!parse_config(argc, argv, config)) {
+        return 2;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto stamp = Clock::now().time_since_epoch().count();
+    auto root = fs::temp_directory_path() / ("fp-cpp-init-perf-scale-" + std::to_string(stamp));
+
+    size_t files = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < config.projects; ++i) {
+        auto opts = options_for(i);
+        auto ctx = fp::make_render_context(opts, "2025");
+        auto written = fp::write_project(fp::generate_project(opts, ctx), root);
+        if (written.is_err()) {
+            std::fprintf(stderr, "%s\n", written.error().c_str());
+            std::error_code ec;
+            fs::remove_all(root, ec);
+            return 1;
+        }
+        files += written.value().size();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::error_code ec;
+    fs::remove_all(root, ec);
+
+    double projects_per_sec = static_cast<double>(config.projects) / seconds;
+    double files_per_sec = static_cast<double>(files) / seconds;
+    double rss_mb = peak_rss_mb();
+
+    std::printf("{\"projects\":%zu,\"files\":%zu,\"seconds\":%.3f,\"projects_per_sec\":%.1f,"
+                "\"files_per_sec\":%.1f,\"peak_rss_mb\":%.1f}\n",
+                config.projects, files, seconds, projects_per_sec, files_per_sec, rss_mb);
+
+    bool ok = true;
+    if (projects_per_sec < config.min_projects_per_sec) {
+        std::fprintf(stderr, "FAIL: %.1f projects/s < %.1f\n", projects_per_sec,
+                     config.min_projects_per_sec);
+        ok = false;
+    }
+    if (files_per_sec < config.min_files_per_sec) {
+        std::fprintf(stderr, "FAIL: %.1f files/s < %.1f\n", files_per_sec,
+                     config.min_files_per_sec);
+        ok = false;
+    }
+    if (config.max_rss_mb > 0 && rss_mb > config.max_rss_mb) {
+        std::fprintf(stderr, "FAIL: peak RSS %.1f MB > %.1f MB\n", rss_mb, config.max_rss_mb);
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -3,7 +3,9 @@
 #include <string>
 #include <vector>
 
+#include "alloc_budget.hpp"
 #include "fp-cpp-init/cli.hpp"
+#include "fp-cpp-init/cli_options.hpp"
 
 using namespace fp;
 
@@ -302,6 +304,16 @@ TEST_CASE("parse_args accepts --author option", "[cli]") {
     REQUIRE(result.value().author == "John Doe");
 }
 
+TEST_CASE("parse_args looks up the git author only for new", "[cli]") {
+    // 其他命令不需要作者，也就不启动 git 子进程
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("serve").add("--socket=/tmp/fp.sock");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().author.empty());
+}
+
 TEST_CASE("parse_args accepts -a short option", "[cli]") {
     ArgvBuilder builder;
     builder.add("fp-cpp-init").add("new").add("test").add("-a=Jane");
@@ -359,6 +371,43 @@ TEST_CASE("parse_args CI and lint enabled by default", "[cli]") {
     REQUIRE(result.is_ok());
     REQUIRE(result.value().enable_ci);
     REQUIRE(result.value().enable_lint);
+    REQUIRE_FALSE(result.value().enable_bench);
+    REQUIRE_FALSE(result.value().enable_pgo);
+    REQUIRE_FALSE(result.value().enable_lto);
+    REQUIRE_FALSE(result.value().enable_fast_build);
+    REQUIRE_FALSE(result.value().enable_profiling);
+    REQUIRE_FALSE(result.value().enable_alloc_tracking);
+    REQUIRE_FALSE(result.value().enable_perf_counters);
+}
+
+TEST_CASE("parse_args feature flags enable only their own option", "[cli]") {
+    // 启用可选功能的开关与对应的 Options 成员
+    struct FeatureFlag {
+        const char* flag;
+        bool Options::*member;
+    };
+    constexpr FeatureFlag feature_flags[] = {
+        {"--bench", &Options::enable_bench},
+        {"--pgo", &Options::enable_pgo},
+        {"--lto", &Options::enable_lto},
+        {"--fast-build", &Options::enable_fast_build},
+        {"--profiling", &Options::enable_profiling},
+        {"--alloc-tracking", &Options::enable_alloc_tracking},
+        {"--perf-counters", &Options::enable_perf_counters},
+    };
+
+    for (const auto& [flag, member] : feature_flags) {
+        INFO(flag);
+        ArgvBuilder builder;
+        builder.add("fp-cpp-init").add("new").add("test").add(flag);
+
+        auto result = parse_args(builder.argc(), builder.argv());
+        REQUIRE(result.is_ok());
+        for (const auto& other : feature_flags) {
+            INFO(other.flag);
+            REQUIRE(result.value().*other.member == (other.member == member));
+        }
+    }
 }
 
 // =============================================================================
@@ -452,3 +501,241 @@ TEST_CASE("get_version_text returns version string", "[cli]") {
     REQUIRE_FALSE(text.empty());
     REQUIRE(text.find("0.1.0") != std::string::npos);
 }
+
+// =============================================================================
+// Trace Option
+// =============================================================================
+
+TEST_CASE("parse_args accepts --trace=<file>", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--trace=out.json");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().trace_path == "out.json");
+}
+
+TEST_CASE("parse_args leaves tracing off by default", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().trace_path.empty());
+}
+
+// =============================================================================
+// Serve Command
+// =============================================================================
+
+TEST_CASE("parse_args serve --socket returns Serve", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("serve").add("--socket=/tmp/fp.sock");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().command == Command::Serve);
+    REQUIRE(result.value().socket_path == "/tmp/fp.sock");
+    REQUIRE(result.value().root_path.empty());
+}
+
+TEST_CASE("parse_args serve --root sets the output root", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("serve").add("--socket=/tmp/fp.sock").add("--root").add("/srv");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().root_path == "/srv");
+}
+
+TEST_CASE("parse_args serve without socket returns error", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("serve");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+}
+
+TEST_CASE("parse_args serve unknown option returns error", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("serve").add("--socket=/tmp/fp.sock").add("--port=1");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+}
+
+TEST_CASE("validate_options rejects invalid values", "[cli]") {
+    Options opts{};
+    opts.type = "exe";
+    opts.license = "mit";
+    opts.cpp_std = "20";
+    REQUIRE(validate_options(opts).is_ok());
+
+    opts.type = "dll";
+    REQUIRE(validate_options(opts).is_err());
+}
+
+// =============================================================================
+// Table-Driven Parser: Space-Separated Values
+// =============================================================================
+
+TEST_CASE("parse_args accepts --opt value form", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init")
+        .add("new")
+        .add("myproject")
+        .add("--type")
+        .add("lib")
+        .add("-l")
+        .add("bsd3")
+        .add("--std")
+        .add("17")
+        .add("-a")
+        .add("Space Author")
+        .add("--desc")
+        .add("Spaced description")
+        .add("--no-lint");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_ok());
+
+    auto opts = result.value();
+    REQUIRE(opts.type == "lib");
+    REQUIRE(opts.license == "bsd3");
+    REQUIRE(opts.cpp_std == "17");
+    REQUIRE(opts.author == "Space Author");
+    REQUIRE(opts.description == "Spaced description");
+    REQUIRE(opts.enable_ci);
+    REQUIRE_FALSE(opts.enable_lint);
+}
+
+TEST_CASE("parse_args validates --opt value form", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--type").add("dll");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "Error: Invalid type 'dll'. Must be: exe, lib, or header");
+}
+
+TEST_CASE("parse_args reports missing option value", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--author");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "Error: Option '--author' requires a value");
+}
+
+TEST_CASE("parse_args does not take the next option as a value", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--author").add("--no-ci");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "Error: Option '--author' requires a value");
+}
+
+TEST_CASE("parse_args keeps '=' inside option values", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--desc=a=b");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().description == "a=b");
+}
+
+// =============================================================================
+// Table-Driven Parser: Compatibility With the Previous Parser
+// =============================================================================
+
+TEST_CASE("parse_args keeps previous error messages", "[cli]") {
+    auto error_for = [](const char* arg) {
+        ArgvBuilder builder;
+        builder.add("fp-cpp-init").add("new").add("test").add(arg);
+        return parse_args(builder.argc(), builder.argv()).error();
+    };
+
+    REQUIRE(error_for("--type=dll") == "Error: Invalid type 'dll'. Must be: exe, lib, or header");
+    REQUIRE(error_for("-l=wtfpl") ==
+            "Error: Invalid license 'wtfpl'. Must be: mit, apache2, gpl3, bsd3, or none");
+    REQUIRE(error_for("--std=11") == "Error: Invalid C++ standard '11'. Must be: 17, 20, or 23");
+    REQUIRE(error_for("--unknown=value") == "Error: Unknown option '--unknown=value'");
+}
+
+TEST_CASE("parse_args treats empty --opt= as unknown option", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--type=");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "Error: Unknown option '--type='");
+}
+
+TEST_CASE("parse_args rejects values on flags", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--no-ci=true");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "Error: Unknown option '--no-ci=true'");
+}
+
+TEST_CASE("parse_args does not match option prefixes", "[cli]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("test").add("--typex=lib");
+
+    auto result = parse_args(builder.argc(), builder.argv());
+    REQUIRE(result.is_err());
+}
+
+TEST_CASE("get_new_help_text lists every option from the schema", "[cli]") {
+    auto text = get_new_help_text();
+    REQUIRE(text.find("    -t, --type=<TYPE>       Project type [default: exe]\n"
+                      "                            Values: exe, lib, header\n") !=
+            std::string::npos);
+    REQUIRE(text.find("    -l, --license=<LICENSE> License type [default: mit]\n") !=
+            std::string::npos);
+    REQUIRE(text.find("    --no-ci                 Disable GitHub Actions CI/CD\n") !=
+            std::string::npos);
+    REQUIRE(text.find("--trace=<FILE>") != std::string::npos);
+    REQUIRE(text.find("--no-lint") != std::string::npos);
+}
+
+// =============================================================================
+// Compile-time Validation
+// =============================================================================
+
+static_assert(cli::validate_type("exe").is_ok());
+static_assert(cli::validate_type("header").value() == "header");
+static_assert(cli::validate_type("dll").is_err());
+static_assert(cli::validate_license("apache2").is_ok());
+static_assert(cli::validate_license("wtfpl").error().message() == "Value is not allowed");
+static_assert(cli::validate_std("23").is_ok());
+static_assert(cli::validate_std("2").is_err());
+static_assert(cli::validate_value(cli::new_options, cli::OptionId::Author, "anyone").is_ok());
+static_assert(cli::validate_value(cli::new_options, cli::OptionId::Socket, "x").is_err());
+static_assert(cli::find_option(cli::serve_options, cli::OptionId::Socket) != nullptr);
+
+TEST_CASE("option validators fold at compile time", "[cli]") {
+    constexpr auto type = cli::validate_type("lib");
+    STATIC_REQUIRE(type.is_ok());
+    constexpr auto unknown = cli::validate_value(cli::serve_options, cli::OptionId::Type, "lib");
+    STATIC_REQUIRE(unknown.error().message() == "Unknown option");
+
+    // 运行期与编译期走同一套校验
+    REQUIRE(cli::validate_license(std::string("bsd3")).is_ok());
+    REQUIRE(cli::validate_std(std::string("14")).is_err());
+}
+
+// =============================================================================
+// Allocation Budgets
+// =============================================================================
+
+TEST_CASE("parse_args stays within its allocation budget", "[cli][alloc]") {
+    ArgvBuilder builder;
+    builder.add("fp-cpp-init").add("new").add("budget").add("--type=lib").add("--license");
+    builder.add("apache2").add("--std=23").add("--author=Budget").add("--no-ci");
+
+    REQUIRE_ALLOCATIONS_AT_MOST(16, parse_args(builder.argc(), builder.argv()));
+}
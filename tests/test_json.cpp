@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+#include "fp-cpp-init/json.hpp"
+
+using namespace fp;
+
+// =============================================================================
+// Escaping
+// =============================================================================
+
+TEST_CASE("json quote escapes special characters", "[json]") {
+    REQUIRE(json::quote("plain") == "\"plain\"");
+    REQUIRE(json::quote("a\"b") == R"("a\"b")");
+    REQUIRE(json::quote("a\\b") == R"("a\\b")");
+    REQUIRE(json::quote("line\nbreak") == R"("line\nbreak")");
+    REQUIRE(json::quote(std::string("\x01", 1)) == R"("\u0001")");
+}
+
+// =============================================================================
+// Flat Object Parsing
+// =============================================================================
+
+TEST_CASE("json parse_flat_object reads strings and booleans", "[json]") {
+    auto result = json::parse_flat_object(R"({"name": "app", "ci": false, "lint": true})");
+    REQUIRE(result.is_ok());
+
+    const auto& obj = result.value();
+    REQUIRE(std::get<std::string>(obj.at("name")) == "app");
+    REQUIRE_FALSE(std::get<bool>(obj.at("ci")));
+    REQUIRE(std::get<bool>(obj.at("lint")));
+}
+
+TEST_CASE("json parse_flat_object keeps numbers as text", "[json]") {
+    auto result = json::parse_flat_object(R"({"std": 23})");
+    REQUIRE(result.is_ok());
+    REQUIRE(std::get<std::string>(result.value().at("std")) == "23");
+}
+
+TEST_CASE("json parse_flat_object decodes escapes", "[json]") {
+    auto result = json::parse_flat_object(R"({"desc": "a\"b\\cé"})");
+    REQUIRE(result.is_ok());
+    REQUIRE(std::get<std::string>(result.value().at("desc")) == "a\"b\\c\xc3\xa9");
+}
+
+TEST_CASE("json parse_flat_object accepts empty object", "[json]") {
+    auto result = json::parse_flat_object("  {}  ");
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().empty());
+}
+
+TEST_CASE("json parse_flat_object rejects malformed input", "[json]") {
+    REQUIRE(json::parse_flat_object("").is_err());
+    REQUIRE(json::parse_flat_object("[]").is_err());
+    REQUIRE(json::parse_flat_object(R"({"a": "b")").is_err());
+    REQUIRE(json::parse_flat_object(R"({"a" "b"})").is_err());
+    REQUIRE(json::parse_flat_object(R"({"a": "b"} x)").is_err());
+}
+
+TEST_CASE("json parse_flat_object rejects nested values", "[json]") {
+    REQUIRE(json::parse_flat_object(R"({"a": {"b": 1}})").is_err());
+    REQUIRE(json::parse_flat_object(R"({"a": [1, 2]})").is_err());
+    REQUIRE(json::parse_flat_object(R"({"a": null})").is_err());
+}
@@ -1,8 +1,14 @@
 #include <catch2/catch_test_macros.hpp>
 #include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
 #include <string>
 
+#include "alloc_budget.hpp"
 #include "fp-cpp-init/project.hpp"
+#include "yaml_lite.hpp"
 
 using namespace fp;
 
@@ -129,6 +135,7 @@ TEST_CASE("generate_project creates lib project structure", "[project]") {
     REQUIRE(has_file(project, "testlib/src/testlib.cpp"));
     REQUIRE(has_file(project, "testlib/tests/CMakeLists.txt"));
     REQUIRE(has_file(project, "testlib/tests/test_main.cpp"));
+    REQUIRE(has_file(project, "testlib/tests/test.hpp"));
 
     // Lib should NOT have release.yml (only exe has that)
     REQUIRE_FALSE(has_file(project, "testlib/.github/workflows/release.yml"));
@@ -194,6 +201,7 @@ TEST_CASE("generate_project creates header project structure", "[project]") {
     REQUIRE(has_file(project, "testheader/examples/example.cpp"));
     REQUIRE(has_file(project, "testheader/tests/CMakeLists.txt"));
     REQUIRE(has_file(project, "testheader/tests/test_main.cpp"));
+    REQUIRE(has_file(project, "testheader/tests/test.hpp"));
 
     // Header should NOT have src directory
     REQUIRE_FALSE(has_dir(project, "testheader/src"));
@@ -282,6 +290,845 @@ TEST_CASE("license none disables license file", "[project]") {
     REQUIRE_FALSE(has_file(project, "test/LICENSE"));
 }
 
+// =============================================================================
+// GitHub Actions CI
+// =============================================================================
+
+namespace {
+
+auto find_step(const yaml_lite::Node& steps, std::string_view name) -> const yaml_lite::Node& {
+    static const yaml_lite::Node missing;
+    for (const auto& step : steps.seq) {
+        if (step["name"].scalar == name) {
+            return step;
+        }
+    }
+    return missing;
+}
+
+} // anonymous namespace
+
+TEST_CASE("yaml_lite parses the workflow subset", "[project]") {
+    auto doc = yaml_lite::parse("a:\n"
+                                "  list: [x, 'y']\n"
+                                "  steps:\n"
+                                "    - name: one\n"
+                                "      run: |\n"
+                                "        echo 1\n"
+                                "\n"
+                                "        # kept\n"
+                                "    - plain\n"
+                                "b: \"quoted: value\"\n");
+    REQUIRE(doc.is_ok());
+    const auto& root = doc.value();
+    REQUIRE(root["a"]["list"].seq.size() == 2);
+    REQUIRE(root["a"]["list"].seq[1].scalar == "y");
+    REQUIRE(root["a"]["steps"].seq.size() == 2);
+    REQUIRE(root["a"]["steps"].seq[0]["run"].scalar == "echo 1\n\n# kept\n");
+    REQUIRE(root["a"]["steps"].seq[1].scalar == "plain");
+    REQUIRE(root["b"].scalar == "quoted: value");
+    REQUIRE(yaml_lite::parse("a:\n\tb: 1\n").is_err());
+}
+
+TEST_CASE("generated CI builds with Ninja and a compiler cache", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "test";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+
+        RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+        auto doc = yaml_lite::parse(get_file_content(project, "test/.github/workflows/ci.yml"));
+        REQUIRE(doc.is_ok());
+
+        const auto& jobs = doc.value()["jobs"];
+        REQUIRE(jobs.has("format"));
+        REQUIRE(jobs.has("coverage"));
+
+        const auto& build = jobs["build"];
+        REQUIRE(build["strategy"]["matrix"]["os"].seq.size() == 3);
+        REQUIRE(build["env"].has("CCACHE_DIR"));
+        REQUIRE(build["env"].has("SCCACHE_DIR"));
+
+        const auto& steps = build["steps"];
+        REQUIRE(steps.is_seq());
+
+        // 缓存键：编译器版本 + 依赖/构建配置文件的哈希，按提交保存、按前缀恢复
+        const auto& key = find_step(steps, "Compute cache key");
+        REQUIRE(key["id"].scalar == "cache-key");
+        REQUIRE(key["run"].scalar.find("--version") != std::string::npos);
+        REQUIRE(key["run"].scalar.find("hashFiles('**/CMakeLists.txt'") != std::string::npos);
+
+        const auto& cache = find_step(steps, "Restore compiler cache");
+        REQUIRE(cache["uses"].scalar == "actions/cache@v4");
+        REQUIRE(cache["with"]["path"].scalar == ".ccache\n.sccache\n");
+        REQUIRE(cache["with"]["key"].scalar.find("steps.cache-key.outputs.prefix") !=
+                std::string::npos);
+        REQUIRE(cache["with"].has("restore-keys"));
+
+        REQUIRE(find_step(steps, "Configure CMake")["run"].scalar.find("-G Ninja") !=
+                std::string::npos);
+        REQUIRE(find_step(steps, "Run tests")["run"].scalar.find("ctest") != std::string::npos);
+        REQUIRE(find_step(steps, "Run tests")["run"].scalar.find(" -j ") != std::string::npos);
+
+        // 缓存必须在构建之前恢复
+        auto index_of = [&steps](std::string_view name) {
+            return std::find_if(steps.seq.begin(), steps.seq.end(),
+                                [name](const auto& s) { return s["name"].scalar == name; }) -
+                   steps.seq.begin();
+        };
+        REQUIRE(index_of("Restore compiler cache") < index_of("Build"));
+    }
+}
+
+TEST_CASE("generated CI gains a bench regression job with --bench", "[project]") {
+    Options opts{};
+    opts.project_name = "my-lib";
+    opts.type = "lib";
+    opts.license = "none";
+    opts.cpp_std = "20";
+
+    RenderContext ctx{.project_name = "my-lib", .cpp_std = "20", .year = "2025"};
+
+    auto plain = yaml_lite::parse(
+        get_file_content(generate_project(opts, ctx), "my-lib/.github/workflows/ci.yml"));
+    REQUIRE(plain.is_ok());
+    REQUIRE_FALSE(plain.value()["jobs"].has("bench"));
+
+    opts.enable_bench = true;
+    auto project = generate_project(opts, ctx);
+    auto doc = yaml_lite::parse(get_file_content(project, "my-lib/.github/workflows/ci.yml"));
+    REQUIRE(doc.is_ok());
+
+    const auto& bench = doc.value()["jobs"]["bench"];
+    REQUIRE(bench["if"].scalar == "github.event_name == 'pull_request'");
+    REQUIRE(bench["env"]["BENCH_THRESHOLD_PCT"].scalar == "15");
+
+    const auto& steps = bench["steps"];
+    REQUIRE(steps.seq.front()["with"]["fetch-depth"].scalar == "0");
+
+    auto base_run = find_step(steps, "Benchmark merge base")["run"].scalar;
+    REQUIRE(base_run.find("git merge-base HEAD") != std::string::npos);
+    REQUIRE(base_run.find("--preset relwithdebinfo-perf") != std::string::npos);
+    REQUIRE(base_run.find("my-lib_bench") != std::string::npos);
+    REQUIRE(base_run.find("--csv=") != std::string::npos);
+    REQUIRE(base_run.find("--repetitions=$BENCH_REPETITIONS") != std::string::npos);
+
+    auto compare_run = find_step(steps, "Benchmark pull request and compare")["run"].scalar;
+    REQUIRE(compare_run.find("-DBENCH_THRESHOLD_PCT=") != std::string::npos);
+    REQUIRE(compare_run.find("--target bench-compare") != std::string::npos);
+}
+
+TEST_CASE("bench-compare target and comparison script are generated", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "test";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_bench = true;
+
+        RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        auto bench_cmake = get_file_content(project, "test/bench/CMakeLists.txt");
+        REQUIRE(bench_cmake.find("add_custom_target(bench-baseline") != std::string::npos);
+        REQUIRE(bench_cmake.find("add_custom_target(bench-compare") != std::string::npos);
+        REQUIRE(bench_cmake.find("set(BENCH_THRESHOLD_PCT 15 CACHE STRING") != std::string::npos);
+        REQUIRE(bench_cmake.find("-DNOISE_K=${BENCH_NOISE_K}") != std::string::npos);
+        REQUIRE(bench_cmake.find("--repetitions=${BENCH_REPETITIONS}") != std::string::npos);
+
+        auto compare = get_file_content(project, "test/bench/compare.cmake");
+        REQUIRE(compare.find("message(FATAL_ERROR \"Benchmarks slower than baseline") !=
+                std::string::npos);
+
+        auto bench_main = get_file_content(project, "test/bench/bench_main.cpp");
+        REQUIRE(bench_main.find("--csv=") != std::string::npos);
+        REQUIRE(get_file_content(project, "test/bench/bench.hpp").find("write_csv") !=
+                std::string::npos);
+    }
+}
+
+namespace {
+
+// 用生成的 compare.cmake 比较两份 CSV，返回 cmake -P 的退出码；没有 cmake 时返回空
+auto run_bench_compare(const std::string& name, const std::string& baseline,
+                       const std::string& current) -> std::optional<int> {
+#ifdef FP_CMAKE_COMMAND
+    Options opts{};
+    opts.project_name = "test";
+    opts.type = "lib";
+    opts.license = "none";
+    opts.cpp_std = "20";
+    opts.enable_bench = true;
+    RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+    auto project = generate_project(opts, ctx);
+
+    auto dir = std::filesystem::temp_directory_path() / ("fp_cpp_init_compare_" + name);
+    std::filesystem::create_directories(dir);
+    auto write = [&dir](const char* file, const std::string& content) {
+        std::ofstream(dir / file) << content;
+    };
+    write("compare.cmake", get_file_content(project, "test/bench/compare.cmake"));
+    write("base.csv", "name,median_ns,mad_ns\n" + baseline);
+    write("head.csv", "name,median_ns,mad_ns\n" + current);
+
+    auto command = std::string("\"") + FP_CMAKE_COMMAND + "\" -DBASELINE=\"" +
+                   (dir / "base.csv").string() + "\" -DCURRENT=\"" +
+                   (dir / "head.csv").string() + "\" -P \"" + (dir / "compare.cmake").string() +
+                   "\" > \"" + (dir / "log.txt").string() + "\" 2>&1";
+    int status = std::system(command.c_str());
+    std::filesystem::remove_all(dir);
+    return status;
+#else
+    (void)name;
+    (void)baseline;
+    (void)current;
+    return std::nullopt;
+#endif
+}
+
+} // anonymous namespace
+
+TEST_CASE("bench compare.cmake ignores slowdowns within the measurement noise", "[project]") {
+    // +25% / +14%，但差值小于 3 x (两次 MAD 之和)
+    auto status = run_bench_compare("noise", "add,2.000,0.300\ngreet,35.000,2.000\n",
+                                    "add,2.500,0.300\ngreet,40.000,2.500\n");
+    if (!status) {
+        WARN("cmake not available (FP_CMAKE_COMMAND undefined)");
+        return;
+    }
+    REQUIRE(*status == 0);
+}
+
+TEST_CASE("bench compare.cmake fails on slowdowns beyond threshold and noise", "[project]") {
+    auto status = run_bench_compare("regression", "parse,40.000,0.500\n", "parse,60.000,0.500\n");
+    if (!status) {
+        WARN("cmake not available (FP_CMAKE_COMMAND undefined)");
+        return;
+    }
+    REQUIRE(*status != 0);
+}
+
+// =============================================================================
+// Build Presets
+// =============================================================================
+
+TEST_CASE("every project type ships CMakePresets.json", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "test";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_ci = false;
+        opts.enable_lint = false;
+
+        RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+        auto presets = get_file_content(project, "test/CMakePresets.json");
+        REQUIRE_FALSE(presets.empty());
+        for (const char* name :
+             {"debug", "release", "relwithdebinfo-perf", "release-native", "release-lto"}) {
+            REQUIRE(presets.find("\"name\": \"" + std::string(name) + "\"") != std::string::npos);
+        }
+        REQUIRE(presets.find("\"ENABLE_FRAME_POINTERS\": \"ON\"") != std::string::npos);
+        REQUIRE(presets.find("\"ENABLE_NATIVE_ARCH\": \"ON\"") != std::string::npos);
+        REQUIRE(presets.find("\"CMAKE_INTERPROCEDURAL_OPTIMIZATION\": \"ON\"") !=
+                std::string::npos);
+
+        // 预设通过缓存变量控制，CMakeLists.txt 不再硬编码优化级别
+        auto cmake = get_file_content(project, "test/CMakeLists.txt");
+        REQUIRE(cmake.find("option(ENABLE_FRAME_POINTERS") != std::string::npos);
+        REQUIRE(cmake.find("option(ENABLE_NATIVE_ARCH") != std::string::npos);
+        REQUIRE(cmake.find("-O3") == std::string::npos);
+        REQUIRE(cmake.find("-O0") == std::string::npos);
+    }
+}
+
+TEST_CASE("every project type detects compiler cache and fast linker", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "test";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+
+        RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+        auto cmake = get_file_content(project, "test/CMakeLists.txt");
+
+        REQUIRE(cmake.find("option(ENABLE_COMPILER_CACHE") != std::string::npos);
+        REQUIRE(cmake.find("find_program(COMPILER_CACHE_PROGRAM NAMES ccache sccache)") !=
+                std::string::npos);
+        REQUIRE(cmake.find("set(CMAKE_CXX_COMPILER_LAUNCHER") != std::string::npos);
+        REQUIRE(cmake.find("option(ENABLE_FAST_LINKER") != std::string::npos);
+        REQUIRE(cmake.find("set(CMAKE_LINKER_TYPE") != std::string::npos);
+        REQUIRE(cmake.find("-fuse-ld=${FAST_LINKER}") != std::string::npos);
+
+        // launcher 与链接选项只对之后创建的 target 生效
+        auto launcher_pos = cmake.find("CMAKE_CXX_COMPILER_LAUNCHER");
+        REQUIRE(launcher_pos > cmake.find("project("));
+        REQUIRE(launcher_pos < cmake.find("add_library"));
+        REQUIRE(launcher_pos < cmake.find("add_executable"));
+    }
+}
+
+// =============================================================================
+// Benchmark Harness (--bench)
+// =============================================================================
+
+TEST_CASE("projects have no bench directory by default", "[project]") {
+    Options opts{};
+    opts.project_name = "test";
+    opts.type = "lib";
+    opts.license = "none";
+    opts.cpp_std = "20";
+
+    RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    REQUIRE_FALSE(has_dir(project, "test/bench"));
+    REQUIRE_FALSE(has_file(project, "test/bench/bench.hpp"));
+    REQUIRE(get_file_content(project, "test/CMakeLists.txt").find("add_subdirectory(bench)") ==
+            std::string::npos);
+}
+
+TEST_CASE("bench flag adds harness to exe project", "[project]") {
+    Options opts{};
+    opts.project_name = "my-app";
+    opts.type = "exe";
+    opts.license = "none";
+    opts.cpp_std = "20";
+    opts.enable_bench = true;
+
+    RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    REQUIRE(has_dir(project, "my-app/bench"));
+    REQUIRE(has_file(project, "my-app/bench/bench.hpp"));
+    REQUIRE(has_file(project, "my-app/bench/bench_main.cpp"));
+    // exe 的函数移到 my_app_core 库，程序与基准共同链接，main.cpp 不进入基准
+    REQUIRE(has_file(project, "my-app/include/my-app/my-app.hpp"));
+    REQUIRE(has_file(project, "my-app/src/my-app.cpp"));
+    auto main_cpp = get_file_content(project, "my-app/src/main.cpp");
+    REQUIRE(main_cpp.find("#include \"my-app/my-app.hpp\"") != std::string::npos);
+    REQUIRE(main_cpp.find("auto greet(") == std::string::npos);
+
+    auto root_cmake = get_file_content(project, "my-app/CMakeLists.txt");
+    REQUIRE(root_cmake.find("add_subdirectory(bench)") != std::string::npos);
+    REQUIRE(root_cmake.find("add_library(my_app_core STATIC ${SOURCES})") != std::string::npos);
+    REQUIRE(root_cmake.find("list(REMOVE_ITEM SOURCES ${CMAKE_SOURCE_DIR}/src/main.cpp)") !=
+            std::string::npos);
+    REQUIRE(root_cmake.find("target_link_libraries(${PROJECT_NAME} PRIVATE my_app_core)") !=
+            std::string::npos);
+
+    auto bench_cmake = get_file_content(project, "my-app/bench/CMakeLists.txt");
+    REQUIRE(bench_cmake.find("target_link_libraries(my-app_bench PRIVATE my_app_core)") !=
+            std::string::npos);
+    REQUIRE(bench_cmake.find("src/main.cpp") == std::string::npos);
+    REQUIRE(bench_cmake.find("main=") == std::string::npos);
+    REQUIRE(bench_cmake.find("add_custom_target(bench") != std::string::npos);
+
+    auto bench_main = get_file_content(project, "my-app/bench/bench_main.cpp");
+    REQUIRE(bench_main.find("namespace bench = my_app::bench;") != std::string::npos);
+    REQUIRE(bench_main.find("#include \"my-app/my-app.hpp\"") != std::string::npos);
+
+    auto harness = get_file_content(project, "my-app/bench/bench.hpp");
+    REQUIRE(harness.find("namespace my_app::bench {") != std::string::npos);
+    REQUIRE(harness.find("do_not_optimize") != std::string::npos);
+    REQUIRE(harness.find("clobber_memory") != std::string::npos);
+    REQUIRE(harness.find("mad_ns") != std::string::npos);
+}
+
+TEST_CASE("bench flag links harness against lib and header projects", "[project]") {
+    for (const char* type : {"lib", "header"}) {
+        Options opts{};
+        opts.project_name = "test";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_bench = true;
+
+        RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        auto headers = std::count_if(project.files.begin(), project.files.end(),
+                                     [](const FileEntry& f) {
+                                         return f.path.string() == "test/include/test/test.hpp";
+                                     });
+        REQUIRE(headers == 1);
+        REQUIRE(get_file_content(project, "test/CMakeLists.txt").find("add_subdirectory(bench)") !=
+                std::string::npos);
+        REQUIRE(get_file_content(project, "test/bench/CMakeLists.txt")
+                    .find("target_link_libraries(test_bench PRIVATE test)") != std::string::npos);
+    }
+}
+
+// =============================================================================
+// Profile-Guided Optimization (--pgo)
+// =============================================================================
+
+TEST_CASE("projects have no pgo module by default", "[project]") {
+    Options opts{};
+    opts.project_name = "test";
+    opts.type = "exe";
+    opts.license = "none";
+    opts.cpp_std = "20";
+
+    RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    REQUIRE_FALSE(has_file(project, "test/cmake/pgo.cmake"));
+    REQUIRE(get_file_content(project, "test/CMakeLists.txt").find("PGO_MODE") ==
+            std::string::npos);
+}
+
+TEST_CASE("pgo flag adds PGO_MODE workflow to every project type", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "my-app";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_pgo = true;
+
+        RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        REQUIRE(has_dir(project, "my-app/cmake"));
+        REQUIRE(has_file(project, "my-app/cmake/pgo_merge.cmake"));
+
+        // 模块必须在任何 target 之前 include，编译选项才会生效
+        auto root_cmake = get_file_content(project, "my-app/CMakeLists.txt");
+        auto include_pos = root_cmake.find("include(cmake/pgo.cmake)");
+        REQUIRE(include_pos != std::string::npos);
+        REQUIRE(include_pos < root_cmake.find("add_executable"));
+        REQUIRE(include_pos < root_cmake.find("add_library"));
+
+        auto pgo = get_file_content(project, "my-app/cmake/pgo.cmake");
+        REQUIRE(pgo.find("set(PGO_MODE \"OFF\" CACHE STRING") != std::string::npos);
+        REQUIRE(pgo.find("-fprofile-generate=") != std::string::npos);
+        REQUIRE(pgo.find("-fprofile-use=${PGO_PROFILE_DIR} -fprofile-correction") !=
+                std::string::npos);
+        REQUIRE(pgo.find("default.profdata") != std::string::npos);
+        REQUIRE(pgo.find("add_custom_target(pgo-train") != std::string::npos);
+        REQUIRE(pgo.find("foreach(candidate my-app_bench ${PROJECT_NAME}") != std::string::npos);
+        REQUIRE(pgo.find("{{") == std::string::npos);
+    }
+}
+
+// =============================================================================
+// Link-Time Optimization (--lto)
+// =============================================================================
+
+TEST_CASE("projects have no lto module by default", "[project]") {
+    Options opts{};
+    opts.project_name = "test";
+    opts.type = "lib";
+    opts.license = "none";
+    opts.cpp_std = "20";
+
+    RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    REQUIRE_FALSE(has_dir(project, "test/cmake"));
+    REQUIRE_FALSE(has_file(project, "test/cmake/lto.cmake"));
+    REQUIRE(get_file_content(project, "test/CMakeLists.txt").find("enable_lto") ==
+            std::string::npos);
+}
+
+TEST_CASE("lto flag checks IPO support and enables it on project targets", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "my-app";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_lto = true;
+        opts.enable_bench = true;
+
+        RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        auto lto = get_file_content(project, "my-app/cmake/lto.cmake");
+        REQUIRE(lto.find("include(CheckIPOSupported)") != std::string::npos);
+        REQUIRE(lto.find("check_ipo_supported(RESULT LTO_SUPPORTED") != std::string::npos);
+        REQUIRE(lto.find("-flto=thin") != std::string::npos);
+        REQUIRE(lto.find("gcc-ar") != std::string::npos);
+        REQUIRE(lto.find("llvm-ar") != std::string::npos);
+        // 只在编译器自带的 archiver 不是 gcc-ar / llvm-ar 时才另行查找
+        REQUIRE(lto.find("lto_ar_name MATCHES \"gcc-ar|llvm-ar\"") != std::string::npos);
+        REQUIRE(lto.find("NOT CMAKE_CXX_COMPILER_AR") == std::string::npos);
+        REQUIRE(lto.find("INTERPROCEDURAL_OPTIMIZATION_RELEASE ON") != std::string::npos);
+
+        // include 在 target 之前，enable_lto 在所有 target（含 bench/）之后
+        auto root_cmake = get_file_content(project, "my-app/CMakeLists.txt");
+        auto include_pos = root_cmake.find("include(cmake/lto.cmake)");
+        auto enable_pos = root_cmake.find("enable_lto(${lto_target})");
+        REQUIRE(include_pos != std::string::npos);
+        REQUIRE(include_pos < root_cmake.find("add_library"));
+        REQUIRE(enable_pos != std::string::npos);
+        REQUIRE(enable_pos > root_cmake.find("add_subdirectory(bench)"));
+        REQUIRE(root_cmake.find("my-app_bench my_app_core)") != std::string::npos);
+    }
+}
+
+TEST_CASE("pgo and lto share the cmake directory", "[project]") {
+    Options opts{};
+    opts.project_name = "test";
+    opts.type = "exe";
+    opts.license = "none";
+    opts.cpp_std = "20";
+    opts.enable_pgo = true;
+    opts.enable_lto = true;
+
+    RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    auto cmake_dirs = std::count(project.directories.begin(), project.directories.end(),
+                                 std::filesystem::path("test/cmake"));
+    REQUIRE(cmake_dirs == 1);
+    REQUIRE(has_file(project, "test/cmake/pgo.cmake"));
+    REQUIRE(has_file(project, "test/cmake/lto.cmake"));
+}
+
+// =============================================================================
+// Fast Builds (--fast-build)
+// =============================================================================
+
+TEST_CASE("fast-build flag adds unity build and precompiled header", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "my-app";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_fast_build = true;
+
+        RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        REQUIRE(has_dir(project, "my-app/pch"));
+        auto pch = get_file_content(project, "my-app/pch/pch.hpp");
+        REQUIRE(pch.find("#include <string>") != std::string::npos);
+        REQUIRE(pch.find("#include <variant>") != std::string::npos);
+        REQUIRE(pch.find("#include <iostream>") != std::string::npos);
+
+        auto fast_build = get_file_content(project, "my-app/cmake/fast_build.cmake");
+        REQUIRE(fast_build.find("option(ENABLE_UNITY_BUILD") != std::string::npos);
+        REQUIRE(fast_build.find("set(UNITY_BUILD_BATCH_SIZE 16 CACHE STRING") !=
+                std::string::npos);
+        REQUIRE(fast_build.find("option(ENABLE_PCH") != std::string::npos);
+        REQUIRE(fast_build.find("target_precompile_headers(${target} PRIVATE") !=
+                std::string::npos);
+
+        // 在所有 target（含 tests/、examples/）定义之后再启用
+        auto root_cmake = get_file_content(project, "my-app/CMakeLists.txt");
+        auto enable_pos = root_cmake.find("enable_fast_build(${fast_target})");
+        REQUIRE(enable_pos != std::string::npos);
+        REQUIRE(enable_pos > root_cmake.find("add_subdirectory(tests)"));
+    }
+}
+
+TEST_CASE("projects have no precompiled header by default", "[project]") {
+    Options opts{};
+    opts.project_name = "test";
+    opts.type = "exe";
+    opts.license = "none";
+    opts.cpp_std = "20";
+
+    RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    REQUIRE_FALSE(has_file(project, "test/pch/pch.hpp"));
+    REQUIRE(get_file_content(project, "test/CMakeLists.txt").find("UNITY_BUILD") ==
+            std::string::npos);
+}
+
+// =============================================================================
+// Profiling Targets (--profiling)
+// =============================================================================
+
+TEST_CASE("profiling flag adds profile script and targets", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "my-app";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_profiling = true;
+
+        RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        REQUIRE(has_dir(project, "my-app/tools"));
+        auto script = get_file_content(project, "my-app/tools/profile.sh");
+        REQUIRE(script.rfind("#!/bin/sh", 0) == 0);
+        REQUIRE(script.find("perf record --call-graph dwarf") != std::string::npos);
+        REQUIRE(script.find("--tool=cachegrind") != std::string::npos);
+        REQUIRE(script.find("heaptrack -o") != std::string::npos);
+
+        auto profiling = get_file_content(project, "my-app/cmake/profiling.cmake");
+        for (const char* name : {"profile-${tool}", "perf_program", "cachegrind_program",
+                                 "heaptrack_program"}) {
+            REQUIRE(profiling.find(name) != std::string::npos);
+        }
+        REQUIRE(profiling.find("set(ENABLE_FRAME_POINTERS ON CACHE BOOL") != std::string::npos);
+        REQUIRE(profiling.find("\"${CMAKE_BINARY_DIR}/profiles\"") != std::string::npos);
+        REQUIRE(profiling.find("find_program(PERF_EXECUTABLE perf)") != std::string::npos);
+
+        // 须在 ENABLE_FRAME_POINTERS 的 option() 之前，默认值才会生效
+        auto root_cmake = get_file_content(project, "my-app/CMakeLists.txt");
+        auto include_pos = root_cmake.find("include(cmake/profiling.cmake)");
+        REQUIRE(include_pos != std::string::npos);
+        REQUIRE(include_pos < root_cmake.find("option(ENABLE_FRAME_POINTERS"));
+    }
+}
+
+// =============================================================================
+// Allocation Tracking (--alloc-tracking)
+// =============================================================================
+
+TEST_CASE("alloc-tracking flag adds counting operator new behind TRACK_ALLOCATIONS", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "my-app";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_alloc_tracking = true;
+
+        RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        REQUIRE(has_dir(project, "my-app/alloc"));
+        auto module = get_file_content(project, "my-app/cmake/alloc_tracking.cmake");
+        REQUIRE(module.find("option(TRACK_ALLOCATIONS") != std::string::npos);
+        REQUIRE(module.find("add_library(my_app_alloc_tracking OBJECT") != std::string::npos);
+        REQUIRE(module.find("\"EXECUTABLE\"") != std::string::npos);
+
+        auto hpp = get_file_content(project, "my-app/alloc/alloc_tracking.hpp");
+        REQUIRE(hpp.find("namespace my_app::alloc_tracking") != std::string::npos);
+        REQUIRE(hpp.find("class AllocationGuard") != std::string::npos);
+        REQUIRE(hpp.find("inline constexpr bool enabled") != std::string::npos);
+
+        auto cpp = get_file_content(project, "my-app/alloc/alloc_tracking.cpp");
+        REQUIRE(cpp.find("thread_local my_app::alloc_tracking::AllocationStats") !=
+                std::string::npos);
+        REQUIRE(cpp.find("auto operator new(std::size_t size) -> void*") != std::string::npos);
+        REQUIRE(cpp.find("auto operator delete(void* p) noexcept -> void") != std::string::npos);
+        // 分配失败时先调用 new-handler 再抛出 bad_alloc
+        REQUIRE(cpp.find("std::get_new_handler()") != std::string::npos);
+
+        auto root_cmake = get_file_content(project, "my-app/CMakeLists.txt");
+        REQUIRE(root_cmake.find("include(cmake/alloc_tracking.cmake)") != std::string::npos);
+        REQUIRE(root_cmake.find("enable_alloc_tracking(${alloc_target})") != std::string::npos);
+    }
+}
+
+TEST_CASE("alloc-tracking adds AllocationGuard tests before main", "[project]") {
+    Options opts{};
+    opts.project_name = "my-app";
+    opts.type = "lib";
+    opts.license = "none";
+    opts.cpp_std = "20";
+    opts.enable_alloc_tracking = true;
+
+    RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    auto test_main = get_file_content(project, "my-app/tests/test_main.cpp");
+    auto include_pos = test_main.find("#include \"alloc_tracking.hpp\"");
+    auto case_pos = test_main.find("TEST_CASE(add_does_not_allocate)");
+    REQUIRE(include_pos != std::string::npos);
+    REQUIRE(case_pos != std::string::npos);
+    REQUIRE(include_pos < case_pos);
+    REQUIRE(case_pos < test_main.find("int main("));
+    REQUIRE(test_main.find("my_app::alloc_tracking::AllocationGuard guard;") != std::string::npos);
+    REQUIRE(test_main.find("TEST_CASE(failed_new_calls_the_new_handler)") != std::string::npos);
+    // Without TRACK_ALLOCATIONS the system operator new is in use; under ASan it aborts
+    auto guarded = "if constexpr (my_app::alloc_tracking::enabled && !address_sanitizer)";
+    REQUIRE(test_main.find(guarded) != std::string::npos);
+}
+
+TEST_CASE("projects have no allocation tracking by default", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "test";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+
+        RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        REQUIRE_FALSE(has_dir(project, "test/alloc"));
+        REQUIRE_FALSE(has_file(project, "test/cmake/alloc_tracking.cmake"));
+        REQUIRE(get_file_content(project, "test/CMakeLists.txt").find("TRACK_ALLOCATIONS") ==
+                std::string::npos);
+        if (has_file(project, "test/tests/test_main.cpp")) {
+            REQUIRE(get_file_content(project, "test/tests/test_main.cpp")
+                        .find("alloc_tracking") == std::string::npos);
+        }
+    }
+}
+
+// =============================================================================
+// Hardware Performance Counters (--perf-counters)
+// =============================================================================
+
+TEST_CASE("perf-counters flag adds the perf_event_open module", "[project]") {
+    for (const char* type : {"exe", "lib", "header"}) {
+        Options opts{};
+        opts.project_name = "my-app";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+        opts.enable_perf_counters = true;
+
+        RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        REQUIRE(has_dir(project, "my-app/perf"));
+        auto hpp = get_file_content(project, "my-app/perf/perf_counters.hpp");
+        REQUIRE(hpp.find("namespace my_app::perf") != std::string::npos);
+        REQUIRE(hpp.find("SYS_perf_event_open") != std::string::npos);
+        for (const char* event : {"PERF_COUNT_HW_CPU_CYCLES", "PERF_COUNT_HW_INSTRUCTIONS",
+                                  "PERF_COUNT_HW_CACHE_MISSES", "PERF_COUNT_HW_BRANCH_MISSES"}) {
+            REQUIRE(hpp.find(event) != std::string::npos);
+        }
+        REQUIRE(hpp.find("class ScopedReader") != std::string::npos);
+        // 非 Linux 或内核拒绝时退化为 available() == false
+        REQUIRE(hpp.find("#if defined(__linux__)") != std::string::npos);
+        REQUIRE(hpp.find("perf_event_paranoid") != std::string::npos);
+
+        auto root_cmake = get_file_content(project, "my-app/CMakeLists.txt");
+        REQUIRE(root_cmake.find("add_library(my_app_perf_counters INTERFACE)") !=
+                std::string::npos);
+        REQUIRE(root_cmake.find("${PROJECT_SOURCE_DIR}/perf") != std::string::npos);
+    }
+}
+
+TEST_CASE("bench and example report hardware counters when present", "[project]") {
+    Options opts{};
+    opts.project_name = "my-app";
+    opts.type = "header";
+    opts.license = "none";
+    opts.cpp_std = "20";
+    opts.enable_bench = true;
+    opts.enable_perf_counters = true;
+
+    RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    for (const char* path : {"my-app/bench/bench_main.cpp", "my-app/examples/example.cpp"}) {
+        auto source = get_file_content(project, path);
+        REQUIRE(source.find("#if __has_include(\"perf_counters.hpp\")") != std::string::npos);
+        REQUIRE(source.find("my_app::perf::ScopedReader reader(") != std::string::npos);
+        REQUIRE(source.find("my_app::perf::summary(*values, calls)") != std::string::npos);
+    }
+}
+
+TEST_CASE("projects have no perf counters by default", "[project]") {
+    Options opts{};
+    opts.project_name = "test";
+    opts.type = "lib";
+    opts.license = "none";
+    opts.cpp_std = "20";
+    opts.enable_bench = true;
+
+    RenderContext ctx{.project_name = "test", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    REQUIRE_FALSE(has_dir(project, "test/perf"));
+    REQUIRE(get_file_content(project, "test/CMakeLists.txt").find("perf_counters") ==
+            std::string::npos);
+}
+
+// =============================================================================
+// Generated Tests
+// =============================================================================
+
+TEST_CASE("generated tests use an always-on CHECK harness", "[project]") {
+    for (const char* type : {"lib", "header"}) {
+        Options opts{};
+        opts.project_name = "my-app";
+        opts.type = type;
+        opts.license = "none";
+        opts.cpp_std = "20";
+
+        RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+        auto project = generate_project(opts, ctx);
+
+        // assert() 在 Release (-DNDEBUG) 下会被编译掉
+        auto test_main = get_file_content(project, "my-app/tests/test_main.cpp");
+        REQUIRE(test_main.find("assert") == std::string::npos);
+        REQUIRE(test_main.find("#include \"test.hpp\"") != std::string::npos);
+        REQUIRE(test_main.find("my_app::test::run(argc, argv)") != std::string::npos);
+
+        auto harness = get_file_content(project, "my-app/tests/test.hpp");
+        REQUIRE(harness.find("#if") == std::string::npos);
+        REQUIRE(harness.find("#define CHECK(expr)") != std::string::npos);
+        REQUIRE(harness.find("#define TEST_CASE(name)") != std::string::npos);
+        REQUIRE(harness.find("std::chrono::steady_clock") != std::string::npos);
+        REQUIRE(harness.find("\"--list\"") != std::string::npos);
+        REQUIRE(harness.find("{{") == std::string::npos);
+    }
+}
+
+TEST_CASE("generated tests register each TEST_CASE with CTest", "[project]") {
+    Options opts{};
+    opts.project_name = "my-app";
+    opts.type = "lib";
+    opts.license = "none";
+    opts.cpp_std = "20";
+
+    RenderContext ctx{.project_name = "my-app", .cpp_std = "20", .year = "2025"};
+
+    auto project = generate_project(opts, ctx);
+
+    // tests/CMakeLists.txt 按行首的 TEST_CASE( 扫描测试名
+    auto test_main = get_file_content(project, "my-app/tests/test_main.cpp");
+    size_t cases = 0;
+    for (size_t pos = test_main.find("\nTEST_CASE("); pos != std::string::npos;
+         pos = test_main.find("\nTEST_CASE(", pos + 1)) {
+        ++cases;
+    }
+    REQUIRE(cases >= 5);
+
+    auto cmake = get_file_content(project, "my-app/tests/CMakeLists.txt");
+    REQUIRE(cmake.find("file(STRINGS test_main.cpp test_case_lines REGEX \"^TEST_CASE\\\\(\")") !=
+            std::string::npos);
+    REQUIRE(cmake.find("add_test(NAME my-app.${test_name} COMMAND tests ${test_name})") !=
+            std::string::npos);
+    REQUIRE(cmake.find("CMAKE_CONFIGURE_DEPENDS test_main.cpp") != std::string::npos);
+}
+
 // =============================================================================
 // License Generation
 // =============================================================================
@@ -446,3 +1293,32 @@ TEST_CASE("project name with underscores works correctly", "[project]") {
     REQUIRE(has_file(project, "my_project/include/my_project/my_project.hpp"));
     REQUIRE(has_file(project, "my_project/src/my_project.cpp"));
 }
+
+// =============================================================================
+// Allocation Budgets
+// =============================================================================
+
+TEST_CASE("generate_project stays within its allocation budget", "[project][alloc]") {
+    Options opts{};
+    opts.command = Command::New;
+    opts.project_name = "budget";
+    opts.license = "mit";
+    opts.cpp_std = "20";
+    opts.enable_ci = true;
+    opts.enable_lint = true;
+
+    RenderContext ctx{
+        .project_name = "budget",
+        .description = "Budget project",
+        .cpp_std = "20",
+        .author = "Budget",
+        .year = "2025",
+        .license_name = "MIT License"};
+
+    opts.type = "exe";
+    REQUIRE_ALLOCATIONS_AT_MOST(100, generate_project(opts, ctx));
+    opts.type = "lib";
+    REQUIRE_ALLOCATIONS_AT_MOST(120, generate_project(opts, ctx));
+    opts.type = "header";
+    REQUIRE_ALLOCATIONS_AT_MOST(120, generate_project(opts, ctx));
+}
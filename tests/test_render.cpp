@@ -1,7 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <string>
 
+#include "alloc_budget.hpp"
 #include "fp-cpp-init/render.hpp"
+#include "fp-cpp-init/templates.hpp"
 
 using namespace fp;
 
@@ -303,3 +305,22 @@ TEST_CASE("get_license_display_name returns empty for unknown license", "[render
     REQUIRE(get_license_display_name("unknown") == "");
     REQUIRE(get_license_display_name("") == "");
 }
+
+// =============================================================================
+// Allocation Budgets
+// =============================================================================
+
+TEST_CASE("render stays within its allocation budget", "[render][alloc]") {
+    RenderContext ctx{
+        .project_name = "budget-project",
+        .description = "A project used for allocation budgets",
+        .cpp_std = "20",
+        .author = "Budget",
+        .year = "2025",
+        .license_name = "MIT License"};
+
+    // 输出字符串按需增长，每次扩容计一次分配
+    REQUIRE_ALLOCATIONS_AT_MOST(8, render(templates::cmake_exe, ctx));
+    REQUIRE_ALLOCATIONS_AT_MOST(8, render(templates::header_only_hpp, ctx));
+    REQUIRE_ALLOCATIONS_AT_MOST(4, render("no placeholders", ctx));
+}
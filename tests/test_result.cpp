@@ -1,6 +1,13 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <charconv>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
+#include "alloc_budget.hpp"
 #include "fp-cpp-init/result.hpp"
 
 using namespace fp;
@@ -125,3 +132,343 @@ TEST_CASE("Result<T> rvalue value access", "[result]") {
     std::string moved = std::move(get_result()).value();
     REQUIRE(moved == "moveable");
 }
+
+// =============================================================================
+// Result<T> Rvalue map / and_then (no copies)
+// =============================================================================
+
+namespace {
+
+// 统计复制与移动次数的载荷类型
+struct CopyCounter {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    std::vector<std::string> payload;
+
+    CopyCounter() = default;
+    explicit CopyCounter(std::vector<std::string> p) : payload(std::move(p)) {}
+    CopyCounter(const CopyCounter& other) : payload(other.payload) { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : payload(std::move(other.payload)) { ++moves; }
+    auto operator=(const CopyCounter& other) -> CopyCounter& {
+        payload = other.payload;
+        ++copies;
+        return *this;
+    }
+    auto operator=(CopyCounter&& other) noexcept -> CopyCounter& {
+        payload = std::move(other.payload);
+        ++moves;
+        return *this;
+    }
+
+    static auto reset() -> void {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+auto make_counter() -> CopyCounter {
+    return CopyCounter{{"a", "b", "c"}};
+}
+
+} // anonymous namespace
+
+TEST_CASE("Result<T> rvalue map moves the value without copies", "[result]") {
+    CopyCounter::reset();
+    auto mapped = Result<CopyCounter>::ok(make_counter()).map([](CopyCounter c) {
+        c.payload.push_back("d");
+        return c;
+    });
+    REQUIRE(mapped.is_ok());
+    REQUIRE(mapped.value().payload.size() == 4);
+    REQUIRE(CopyCounter::copies == 0);
+}
+
+TEST_CASE("Result<T> rvalue and_then moves the value without copies", "[result]") {
+    CopyCounter::reset();
+    auto chained =
+        Result<CopyCounter>::ok(make_counter())
+            .and_then([](CopyCounter c) { return Result<CopyCounter>::ok(std::move(c)); })
+            .map([](CopyCounter c) { return c.payload.size(); });
+    REQUIRE(chained.is_ok());
+    REQUIRE(chained.value() == 3);
+    REQUIRE(CopyCounter::copies == 0);
+}
+
+TEST_CASE("Result<T> lvalue map still copies and leaves the source intact", "[result]") {
+    CopyCounter::reset();
+    auto source = Result<CopyCounter>::ok(make_counter());
+    auto mapped = source.map([](CopyCounter c) { return c.payload.size(); });
+    REQUIRE(mapped.value() == 3);
+    REQUIRE(CopyCounter::copies == 1);
+    REQUIRE(source.value().payload.size() == 3);
+}
+
+TEST_CASE("Result<T> rvalue map moves the error through", "[result]") {
+    // 足够长以避开 SSO，可以通过缓冲区地址判断是否发生了移动
+    std::string message(64, 'x');
+    auto source = Result<CopyCounter>::err(std::move(message));
+    const char* buffer = source.error().data();
+
+    CopyCounter::reset();
+    auto mapped = std::move(source)
+                      .map([](CopyCounter c) { return c; })
+                      .and_then([](CopyCounter c) { return Result<int>::ok(c.payload.size()); });
+    REQUIRE(mapped.is_err());
+    REQUIRE(mapped.error().data() == buffer);
+    REQUIRE(CopyCounter::copies == 0);
+    REQUIRE(CopyCounter::moves == 0);
+}
+
+TEST_CASE("Result<T> rvalue value_or moves the value", "[result]") {
+    CopyCounter::reset();
+    auto value = Result<CopyCounter>::ok(make_counter()).value_or(CopyCounter{});
+    REQUIRE(value.payload.size() == 3);
+    REQUIRE(CopyCounter::copies == 0);
+}
+
+// =============================================================================
+// Result<T, E> Custom Error Types
+// =============================================================================
+
+namespace {
+
+enum class ParseError : unsigned char { Empty, NotANumber };
+
+} // anonymous namespace
+
+TEST_CASE("Result<T, E> stores an enum error", "[result]") {
+    auto r = Result<int, ParseError>::err(ParseError::NotANumber);
+    REQUIRE(r.is_err());
+    REQUIRE(r.error() == ParseError::NotANumber);
+}
+
+TEST_CASE("Result<T, E> map and and_then keep the error type", "[result]") {
+    auto to_text = [](int x) { return Result<std::string, ParseError>::ok(std::to_string(x)); };
+    auto r = Result<int, ParseError>::ok(21).map([](int x) { return x * 2; }).and_then(to_text);
+    REQUIRE(r.is_ok());
+    REQUIRE(r.value() == "42");
+
+    auto e = Result<int, ParseError>::err(ParseError::Empty).map([](int x) { return x + 1; });
+    REQUIRE(e.is_err());
+    REQUIRE(e.error() == ParseError::Empty);
+}
+
+TEST_CASE("Result<T, StaticError> keeps the static message pointer", "[result]") {
+    static constexpr char message[] = "static failure message that would not fit in SSO";
+    auto r = Result<int, StaticError>::err(message);
+    REQUIRE(r.is_err());
+    REQUIRE(r.error().c_str() == message);
+    REQUIRE(r.error() == StaticError("static failure message that would not fit in SSO"));
+    REQUIRE(r.error().message().size() == std::string_view(message).size());
+}
+
+// 只能由字符串字面量 / "..."_err 构造，运行期的 const char* 可能悬空，不允许传入
+static_assert(std::is_constructible_v<StaticError, const char (&)[6]>);
+static_assert(!std::is_constructible_v<StaticError, const char*>);
+static_assert(!std::is_convertible_v<const char*, StaticError>);
+
+TEST_CASE("Result<T> with T equal to E stays unambiguous", "[result]") {
+    auto ok = Result<std::string, std::string>::ok("value");
+    auto err = Result<std::string, std::string>::err("error");
+    REQUIRE(ok.is_ok());
+    REQUIRE(err.is_err());
+    REQUIRE(err.error() == "error");
+}
+
+// =============================================================================
+// Result<void, E> Compact Layout
+// =============================================================================
+
+static_assert(sizeof(Result<void>) == sizeof(void*));
+static_assert(sizeof(Result<void, ParseError>) <= 2);
+static_assert(sizeof(Result<int, ParseError>) <= 2 * sizeof(int));
+static_assert(sizeof(Result<void, StaticError>) <= 2 * sizeof(void*));
+
+TEST_CASE("Result<void, E> copies and moves errors", "[result]") {
+    auto r = Result<void>::err("boxed error");
+    auto copy = r;
+    REQUIRE(copy.is_err());
+    REQUIRE(copy.error() == "boxed error");
+    REQUIRE(r.error() == "boxed error");
+
+    auto moved = std::move(copy);
+    REQUIRE(moved.is_err());
+    REQUIRE(moved.error() == "boxed error");
+
+    auto assigned = Result<void>::ok();
+    assigned = r;
+    REQUIRE(assigned.is_err());
+    assigned = Result<void>::ok();
+    REQUIRE(assigned.is_ok());
+}
+
+TEST_CASE("Result<void> keeps long messages and propagates them", "[result]") {
+    const std::string message = "a message that is too long for the small string buffer";
+    auto r = Result<void>::err(message);
+    REQUIRE(r.error() == message);
+    REQUIRE(Result<void>::err(std::string_view{}).error().empty());
+
+    auto propagated = Result<int>::err(r.error());
+    REQUIRE(propagated.error() == message);
+}
+
+TEST_CASE("Result<void>::err allocates once", "[result][alloc]") {
+    // 长度与字符放在同一块内存里，不再另外分配 std::string
+    REQUIRE_ALLOCATIONS_AT_MOST(
+        1, Result<void>::err("a message that is too long for the small string buffer"));
+    const std::string message(100, 'x');
+    REQUIRE_ALLOCATIONS_AT_MOST(1, Result<void>::err(message));
+}
+
+TEST_CASE("Result<void, E> stores small errors inline", "[result]") {
+    auto r = Result<void, ParseError>::err(ParseError::Empty);
+    REQUIRE(r.is_err());
+    REQUIRE(r.error() == ParseError::Empty);
+    REQUIRE(Result<void, ParseError>::ok().is_ok());
+}
+
+TEST_CASE("Result<void> and_then chains into a value", "[result]") {
+    auto ok = Result<void>::ok().and_then([] { return Result<int>::ok(7); });
+    REQUIRE(ok.is_ok());
+    REQUIRE(ok.value() == 7);
+
+    auto err = Result<void>::err("stop").and_then([] { return Result<int>::ok(7); });
+    REQUIRE(err.is_err());
+    REQUIRE(err.error() == "stop");
+
+    auto mapped = Result<void>::ok().map([] { return 3; });
+    REQUIRE(mapped.value() == 3);
+}
+
+// =============================================================================
+// Constant Evaluation
+// =============================================================================
+
+namespace {
+
+using namespace fp::literals;
+
+using Digit = Result<int, StaticError>;
+
+constexpr auto parse_digit(char c) -> Digit {
+    if (c < '0' || c > '9') {
+        return Digit::err("not a digit"_err);
+    }
+    return Digit::ok(c - '0');
+}
+
+constexpr auto check_even(int n) -> Result<void, StaticError> {
+    if (n % 2 != 0) {
+        return Result<void, StaticError>::err("odd"_err);
+    }
+    return Result<void, StaticError>::ok();
+}
+
+} // anonymous namespace
+
+static_assert(parse_digit('7').is_ok());
+static_assert(parse_digit('7').value() == 7);
+static_assert(parse_digit('x').error() == "not a digit"_err);
+static_assert(parse_digit('4').map([](int n) { return n * 10; }).value() == 40);
+static_assert(parse_digit('4').and_then([](int n) { return parse_digit(char('0' + n + 1)); })
+                  .value_or(-1) == 5);
+static_assert(parse_digit('x').map([](int n) { return n * 10; }).value_or(-1) == -1);
+static_assert(check_even(4).is_ok());
+static_assert(check_even(3).error().message() == "odd");
+static_assert(check_even(2).and_then([] { return parse_digit('9'); }).value() == 9);
+static_assert(Result<void, int>::err(5).map([] { return 1; }).error() == 5);
+
+TEST_CASE("Result is usable in constant expressions", "[result]") {
+    constexpr auto digit = parse_digit('3');
+    STATIC_REQUIRE(digit.value() == 3);
+    constexpr auto bad = parse_digit('?');
+    STATIC_REQUIRE(bad.error().message() == "not a digit");
+    REQUIRE(bad.error().c_str() == bad.error().c_str());
+}
+
+// =============================================================================
+// Result Backends (std::variant vs std::expected)
+// =============================================================================
+
+#if FP_RESULT_HAS_EXPECTED
+using ResultBackends = std::tuple<detail::VariantBackend, detail::ExpectedBackend>;
+#else
+using ResultBackends = std::tuple<detail::VariantBackend>;
+#endif
+
+TEMPLATE_LIST_TEST_CASE("Result backends share the same semantics", "[result]", ResultBackends) {
+    using R = Result<std::string, std::string, TestType>;
+
+    auto ok = R::ok("value");
+    REQUIRE(ok.is_ok());
+    REQUIRE(ok.value() == "value");
+    REQUIRE(ok.map([](const std::string& v) { return v.size(); }).value() == 5);
+
+    auto err = R::err("error");
+    REQUIRE(err.is_err());
+    REQUIRE(err.error() == "error");
+    REQUIRE(err.value_or("fallback") == "fallback");
+
+    auto chained = std::move(ok).and_then([](std::string v) { return R::ok(v + "!"); });
+    REQUIRE(chained.value() == "value!");
+}
+
+namespace {
+
+template <typename Backend>
+using BenchResult = Result<int, std::string, Backend>;
+
+template <typename Backend>
+auto parse_number(std::string_view input) -> BenchResult<Backend> {
+    int value = 0;
+    auto [end, ec] = std::from_chars(input.data(), input.data() + input.size(), value);
+    if (ec != std::errc{} || end != input.data() + input.size()) {
+        return BenchResult<Backend>::err("not a number");
+    }
+    return BenchResult<Backend>::ok(value);
+}
+
+// 解析 -> 变换 -> 可能失败的校验 -> 变换，统计成功值之和
+template <typename Backend>
+auto run_chain(const std::vector<std::string>& inputs) -> long {
+    long sum = 0;
+    for (const auto& input : inputs) {
+        sum += parse_number<Backend>(input)
+                   .map([](int x) { return x * 2; })
+                   .and_then([](int x) {
+                       return x % 7 == 0 ? BenchResult<Backend>::err("multiple of seven")
+                                         : BenchResult<Backend>::ok(x + 1);
+                   })
+                   .map([](int x) { return x - 1; })
+                   .value_or(0);
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Result backends agree on the chained-transform workload", "[result]") {
+    std::vector<std::string> inputs{"1", "7", "x", "21", "100"};
+    auto expected = run_chain<detail::VariantBackend>(inputs);
+    REQUIRE(expected == 2 + 0 + 0 + 0 + 200);
+    REQUIRE(run_chain<detail::DefaultBackend>(inputs) == expected);
+}
+
+// 默认隐藏，运行：tests "[benchmark]"
+TEST_CASE("Result backend benchmark: chained transforms", "[.][benchmark][result]") {
+    std::vector<std::string> inputs;
+    inputs.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        inputs.push_back(i % 10 == 0 ? "invalid" : std::to_string(i));
+    }
+
+    BENCHMARK("variant backend") {
+        return run_chain<detail::VariantBackend>(inputs);
+    };
+#if FP_RESULT_HAS_EXPECTED
+    BENCHMARK("expected backend") {
+        return run_chain<detail::ExpectedBackend>(inputs);
+    };
+#endif
+}
@@ -0,0 +1,258 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <string>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <thread>
+#endif
+
+#include "fp-cpp-init/serve.hpp"
+
+using namespace fp;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 服务根目录：请求的 dir 相对于它解析
+const fs::path root = fs::weakly_canonical(fs::temp_directory_path());
+
+const serve::Defaults defaults{.author = "Daemon Author", .year = "2025", .root = root};
+
+// 为每个测试在根目录下创建独立的临时输出目录，返回其相对路径
+auto make_temp_dir(const std::string& name) -> std::string {
+    auto relative = "fp_cpp_init_serve_" + name;
+    fs::remove_all(root / relative);
+    fs::create_directories(root / relative);
+    return relative;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Request Parsing
+// =============================================================================
+
+TEST_CASE("serve parse_request applies defaults", "[serve]") {
+    auto result = serve::parse_request(R"({"name": "app"})", defaults);
+    REQUIRE(result.is_ok());
+
+    const auto& req = result.value();
+    REQUIRE(req.opts.command == Command::New);
+    REQUIRE(req.opts.project_name == "app");
+    REQUIRE(req.opts.type == "exe");
+    REQUIRE(req.opts.license == "mit");
+    REQUIRE(req.opts.cpp_std == "20");
+    REQUIRE(req.opts.author == "Daemon Author");
+    REQUIRE(req.opts.enable_ci);
+    REQUIRE(req.opts.enable_lint);
+    REQUIRE(req.dir == root);
+}
+
+TEST_CASE("serve parse_request reads all fields", "[serve]") {
+    auto result = serve::parse_request(
+        R"({"name": "lib1", "type": "lib", "license": "bsd3", "std": "23", "author": "A",)"
+        R"( "desc": "D", "ci": false, "lint": false, "dir": "out/sub"})",
+        defaults);
+    REQUIRE(result.is_ok());
+
+    const auto& req = result.value();
+    REQUIRE(req.opts.type == "lib");
+    REQUIRE(req.opts.license == "bsd3");
+    REQUIRE(req.opts.cpp_std == "23");
+    REQUIRE(req.opts.author == "A");
+    REQUIRE(req.opts.description == "D");
+    REQUIRE_FALSE(req.opts.enable_ci);
+    REQUIRE_FALSE(req.opts.enable_lint);
+    REQUIRE(req.dir == root / "out" / "sub");
+}
+
+TEST_CASE("serve parse_request reads the feature flags", "[serve]") {
+    // JSON 字段与对应的 Options 成员
+    struct FeatureFlag {
+        const char* key;
+        bool Options::*member;
+    };
+    constexpr FeatureFlag feature_flags[] = {
+        {"bench", &Options::enable_bench},
+        {"pgo", &Options::enable_pgo},
+        {"lto", &Options::enable_lto},
+        {"fast_build", &Options::enable_fast_build},
+        {"profiling", &Options::enable_profiling},
+        {"alloc_tracking", &Options::enable_alloc_tracking},
+        {"perf_counters", &Options::enable_perf_counters},
+    };
+
+    auto plain = serve::parse_request(R"({"name": "a"})", defaults);
+    REQUIRE(plain.is_ok());
+    for (const auto& [key, member] : feature_flags) {
+        INFO(key);
+        REQUIRE_FALSE(plain.value().opts.*member);
+
+        auto req = serve::parse_request(
+            std::string(R"({"name": "a", ")") + key + R"(": true})", defaults);
+        REQUIRE(req.is_ok());
+        for (const auto& other : feature_flags) {
+            INFO(other.key);
+            REQUIRE(req.value().opts.*other.member == (other.member == member));
+        }
+    }
+}
+
+TEST_CASE("serve parse_request validates options", "[serve]") {
+    REQUIRE(serve::parse_request(R"({"name": "a", "type": "dll"})", defaults).is_err());
+    REQUIRE(serve::parse_request(R"({"name": "a", "license": "x"})", defaults).is_err());
+    REQUIRE(serve::parse_request(R"({"name": "a", "std": "11"})", defaults).is_err());
+    REQUIRE(serve::parse_request(R"({"name": "a", "ci": "yes"})", defaults).is_err());
+}
+
+TEST_CASE("serve parse_request keeps dir under the server root", "[serve]") {
+    for (const char* dir : {"/etc", "../x", "a/../../x", "a/.."}) {
+        auto request = R"({"name": "a", "dir": ")" + std::string(dir) + R"("})";
+        INFO(dir);
+        REQUIRE(serve::parse_request(request, defaults).is_err());
+    }
+    REQUIRE(serve::parse_request(R"({"name": "a", "dir": "./a/b"})", defaults).value().dir ==
+            root / "a" / "b");
+}
+
+TEST_CASE("serve parse_request rejects dirs that escape through a symlink", "[serve]") {
+    auto dir = make_temp_dir("symlink");
+    std::error_code ec;
+    fs::create_directory_symlink(fs::path("/"), root / dir / "escape", ec);
+    if (ec) {
+        WARN("cannot create symlinks here: " << ec.message());
+        fs::remove_all(root / dir);
+        return;
+    }
+
+    auto request = R"({"name": "a", "dir": ")" + dir + R"(/escape/etc"})";
+    REQUIRE(serve::parse_request(request, defaults).is_err());
+
+    fs::remove_all(root / dir);
+}
+
+TEST_CASE("serve parse_request rejects unsafe project names", "[serve]") {
+    REQUIRE(serve::parse_request(R"({})", defaults).is_err());
+    REQUIRE(serve::parse_request(R"({"name": "-x"})", defaults).is_err());
+    REQUIRE(serve::parse_request(R"({"name": ".."})", defaults).is_err());
+    REQUIRE(serve::parse_request(R"({"name": "a/b"})", defaults).is_err());
+}
+
+// =============================================================================
+// Request Handling
+// =============================================================================
+
+TEST_CASE("serve handle_request writes project and lists files", "[serve]") {
+    auto dir = make_temp_dir("ok");
+    auto response = serve::handle_request(
+        R"({"name": "app", "dir": ")" + dir + R"("})", defaults);
+
+    REQUIRE(response.find("\"ok\":true") != std::string::npos);
+    REQUIRE(response.find("app/CMakeLists.txt") != std::string::npos);
+    REQUIRE(fs::exists(root / dir / "app" / "src" / "main.cpp"));
+
+    fs::remove_all(root / dir);
+}
+
+TEST_CASE("serve handle_request refuses existing project directory", "[serve]") {
+    auto dir = make_temp_dir("exists");
+    fs::create_directories(root / dir / "app");
+
+    auto response =
+        serve::handle_request(R"({"name": "app", "dir": ")" + dir + R"("})", defaults);
+    REQUIRE(response.find("\"ok\":false") != std::string::npos);
+    REQUIRE(response.find("already exists") != std::string::npos);
+
+    fs::remove_all(root / dir);
+}
+
+TEST_CASE("serve handle_request reports parse errors as JSON", "[serve]") {
+    auto response = serve::handle_request("not json", defaults);
+    REQUIRE(response.rfind("{\"ok\":false,\"error\":", 0) == 0);
+}
+
+// =============================================================================
+// Socket Server
+// =============================================================================
+
+#ifndef _WIN32
+
+namespace {
+
+// 连接 Unix socket；服务端尚未 listen 时每 10ms 重试一次，失败返回 -1
+auto connect_to(const std::string& socket_path, int attempts = 200) -> int {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    for (int attempt = 0; attempt < attempts; ++attempt) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+// 读取一行响应（不含换行）
+auto read_line(int fd) -> std::string {
+    std::string line;
+    char c = 0;
+    while (::recv(fd, &c, 1, 0) == 1 && c != '\n') {
+        line += c;
+    }
+    return line;
+}
+
+} // anonymous namespace
+
+TEST_CASE("serve run answers concurrent connections and stops on SIGTERM", "[serve]") {
+    auto dir = root / make_temp_dir("run");
+    auto socket_path = (dir / "fp.sock").string();
+
+    auto result = Result<void>::ok();
+    std::thread server([&] { result = serve::run(socket_path, dir.string()); });
+
+    // 两个连接同时保持打开：第二个请求不必等第一个连接关闭
+    int first = connect_to(socket_path);
+    int second = connect_to(socket_path);
+    REQUIRE(first >= 0);
+    REQUIRE(second >= 0);
+    std::string request_one = R"({"name": "one", "type": "lib"})" "\n";
+    std::string request_two = R"({"name": "two", "type": "lib"})" "\n";
+    REQUIRE(::send(first, request_one.data(), request_one.size(), 0) > 0);
+    REQUIRE(::send(second, request_two.data(), request_two.size(), 0) > 0);
+    auto response_two = read_line(second);
+    auto response_one = read_line(first);
+    ::close(first);
+    ::close(second);
+
+    // 信号只发给服务线程以打断 accept()；再连一次，防止信号落在检查与 accept 之间
+    ::pthread_kill(server.native_handle(), SIGTERM);
+    int wake = connect_to(socket_path, 1);
+    if (wake >= 0) {
+        ::close(wake);
+    }
+    server.join();
+
+    REQUIRE(result.is_ok());
+    REQUIRE(response_one.rfind("{\"ok\":true", 0) == 0);
+    REQUIRE(response_two.rfind("{\"ok\":true", 0) == 0);
+    REQUIRE(fs::exists(dir / "one" / "CMakeLists.txt"));
+    REQUIRE(fs::exists(dir / "two" / "CMakeLists.txt"));
+    REQUIRE_FALSE(fs::exists(socket_path));
+
+    fs::remove_all(dir);
+}
+
+#endif
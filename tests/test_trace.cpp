@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include "fp-cpp-init/render.hpp"
+#include "fp-cpp-init/trace.hpp"
+
+using namespace fp;
+
+// 统计子串出现次数
+auto count_occurrences(const std::string& haystack, const std::string& needle) -> size_t {
+    size_t count = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string::npos;
+         pos = haystack.find(needle, pos + needle.size())) {
+        ++count;
+    }
+    return count;
+}
+
+// 测试期间开启记录，结束时关闭并清空，避免影响其他测试
+struct TraceSession {
+    TraceSession() {
+        trace::enable();
+        trace::reset();
+    }
+    ~TraceSession() {
+        trace::disable();
+        trace::reset();
+    }
+    TraceSession(const TraceSession&) = delete;
+    auto operator=(const TraceSession&) -> TraceSession& = delete;
+};
+
+// =============================================================================
+// Span Recording
+// =============================================================================
+
+TEST_CASE("trace to_json produces a trace-event document", "[trace]") {
+    trace::reset();
+    auto json = trace::to_json();
+    REQUIRE(json.find("\"traceEvents\":[") != std::string::npos);
+    REQUIRE(json.find("\"displayTimeUnit\"") != std::string::npos);
+}
+
+TEST_CASE("trace records spans when enabled", "[trace]") {
+    TraceSession session;
+    {
+        trace::Span span("io", "write_file", "out/file.txt");
+    }
+    auto json = trace::to_json();
+    REQUIRE(json.find("\"name\":\"write_file\"") != std::string::npos);
+    REQUIRE(json.find("\"cat\":\"io\"") != std::string::npos);
+    REQUIRE(json.find("\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"detail\":\"out/file.txt\"") != std::string::npos);
+    REQUIRE(json.find("\"tid\":") != std::string::npos);
+}
+
+TEST_CASE("trace records a span per render call", "[trace]") {
+    TraceSession session;
+    RenderContext ctx{.project_name = "p",
+                      .description = "",
+                      .cpp_std = "20",
+                      .author = "",
+                      .year = "2025",
+                      .license_name = ""};
+    render("{{PROJECT_NAME}}", ctx);
+    render("{{YEAR}}", ctx);
+    REQUIRE(count_occurrences(trace::to_json(), "\"name\":\"render\"") == 2);
+}
+
+TEST_CASE("trace escapes span details", "[trace]") {
+    TraceSession session;
+    {
+        trace::Span span("io", "write_file", "dir\\name\"quoted\"");
+    }
+    REQUIRE(trace::to_json().find(R"("detail":"dir\\name\"quoted\"")") != std::string::npos);
+}
+
+TEST_CASE("trace keeps per-thread buffers with distinct tids", "[trace]") {
+    TraceSession session;
+    {
+        trace::Span span("test", "main_thread");
+    }
+    std::thread worker([] { trace::Span span("test", "worker_thread"); });
+    worker.join();
+
+    auto json = trace::to_json();
+    auto main_pos = json.find("\"name\":\"main_thread\"");
+    auto worker_pos = json.find("\"name\":\"worker_thread\"");
+    REQUIRE(main_pos != std::string::npos);
+    REQUIRE(worker_pos != std::string::npos);
+
+    auto tid_of = [&json](size_t pos) {
+        auto tid_pos = json.find("\"tid\":", pos);
+        return json.substr(tid_pos, json.find_first_of(",}", tid_pos) - tid_pos);
+    };
+    REQUIRE(tid_of(main_pos) != tid_of(worker_pos));
+}
+
+TEST_CASE("trace records nothing after disable", "[trace]") {
+    {
+        TraceSession session;
+        trace::disable();
+        REQUIRE_FALSE(trace::is_enabled());
+        {
+            trace::Span span("test", "disabled_span");
+        }
+        REQUIRE(trace::to_json().find("disabled_span") == std::string::npos);
+    }
+    REQUIRE_FALSE(trace::is_enabled());
+}
+
+// =============================================================================
+// Trace File
+// =============================================================================
+
+TEST_CASE("trace write_json writes the document", "[trace]") {
+    TraceSession session;
+    {
+        trace::Span span("io", "write_file");
+    }
+    auto path = std::filesystem::temp_directory_path() / "fp_cpp_init_trace_test.json";
+    auto result = trace::write_json(path);
+    REQUIRE(result.is_ok());
+    REQUIRE(std::filesystem::file_size(path) == trace::to_json().size());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("trace write_json reports a file it cannot create", "[trace]") {
+    auto result = trace::write_json(std::filesystem::temp_directory_path());
+    REQUIRE(result.is_err());
+    REQUIRE(result.error().find("Error creating trace file") != std::string::npos);
+}
+
+#ifdef __linux__
+TEST_CASE("trace write_json reports a failed write", "[trace]") {
+    // /dev/full 可以打开，但每次写入都返回 ENOSPC
+    auto result = trace::write_json("/dev/full");
+    REQUIRE(result.is_err());
+    REQUIRE(result.error().find("Error writing trace file") != std::string::npos);
+}
+#endif
@@ -0,0 +1,223 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fp-cpp-init/traverse.hpp"
+
+using namespace fp;
+
+namespace {
+
+auto parse_positive(int x) -> Result<int> {
+    if (x <= 0) {
+        return Result<int>::err("not positive: " + std::to_string(x));
+    }
+    return Result<int>::ok(x);
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// collect
+// =============================================================================
+
+TEST_CASE("collect gathers all ok values in order", "[traverse]") {
+    std::vector<Result<int>> results{Result<int>::ok(1), Result<int>::ok(2), Result<int>::ok(3)};
+    auto collected = collect(results);
+    REQUIRE(collected.is_ok());
+    REQUIRE(collected.value() == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("collect returns the first error", "[traverse]") {
+    std::vector<Result<int>> results{
+        Result<int>::ok(1), Result<int>::err("first"), Result<int>::err("second")};
+    auto collected = collect(results);
+    REQUIRE(collected.is_err());
+    REQUIRE(collected.error() == "first");
+}
+
+TEST_CASE("collect of an empty range is ok", "[traverse]") {
+    std::vector<Result<int>> results;
+    auto collected = collect(results);
+    REQUIRE(collected.is_ok());
+    REQUIRE(collected.value().empty());
+}
+
+TEST_CASE("collect moves values out of an owning rvalue range", "[traverse]") {
+    std::vector<Result<std::string>> results;
+    results.push_back(Result<std::string>::ok(std::string(64, 'a')));
+    const char* buffer = results.front().value().data();
+
+    auto collected = collect(std::move(results));
+    REQUIRE(collected.is_ok());
+    REQUIRE(collected.value().front().data() == buffer);
+}
+
+TEST_CASE("collect moves the error out of an owning rvalue range", "[traverse]") {
+    std::vector<Result<int>> results;
+    results.push_back(Result<int>::ok(1));
+    results.push_back(Result<int>::err(std::string(64, 'e')));
+    const char* buffer = results.back().error().data();
+
+    auto collected = collect(std::move(results));
+    REQUIRE(collected.is_err());
+    REQUIRE(collected.error().data() == buffer);
+}
+
+TEST_CASE("collect folds Result<void> sequences", "[traverse]") {
+    std::vector<Result<void>> ok{Result<void>::ok(), Result<void>::ok()};
+    REQUIRE(collect(ok).is_ok());
+
+    std::vector<Result<void>> failed{Result<void>::ok(), Result<void>::err("boom")};
+    auto collected = collect(failed);
+    REQUIRE(collected.is_err());
+    REQUIRE(collected.error() == "boom");
+}
+
+TEST_CASE("collect accepts lazy views", "[traverse]") {
+    auto collected = collect(std::views::iota(1, 4) | std::views::transform(parse_positive));
+    REQUIRE(collected.is_ok());
+    REQUIRE(collected.value() == std::vector<int>{1, 2, 3});
+}
+
+// =============================================================================
+// traverse
+// =============================================================================
+
+TEST_CASE("traverse maps every element", "[traverse]") {
+    std::vector<int> input{1, 2, 3};
+    auto result = traverse(input, [](int x) { return Result<std::string>::ok(std::to_string(x)); });
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value() == std::vector<std::string>{"1", "2", "3"});
+}
+
+TEST_CASE("traverse stops at the first error", "[traverse]") {
+    std::vector<int> input{1, -2, 3, -4};
+    int calls = 0;
+    auto result = traverse(input, [&calls](int x) {
+        ++calls;
+        return parse_positive(x);
+    });
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "not positive: -2");
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("traverse with Result<void> steps returns Result<void>", "[traverse]") {
+    std::vector<int> input{1, 2, 3};
+    int sum = 0;
+    auto result = traverse(input, [&sum](int x) {
+        sum += x;
+        return Result<void>::ok();
+    });
+    REQUIRE(result.is_ok());
+    REQUIRE(sum == 6);
+}
+
+TEST_CASE("traverse keeps a custom error type", "[traverse]") {
+    std::vector<int> input{1, 0};
+    auto result = traverse(input, [](int x) {
+        return x == 0 ? Result<int, StaticError>::err("zero") : Result<int, StaticError>::ok(x);
+    });
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == StaticError("zero"));
+}
+
+// =============================================================================
+// parallel_traverse
+// =============================================================================
+
+TEST_CASE("parallel_traverse preserves input order", "[traverse]") {
+    std::vector<int> input;
+    for (int i = 1; i <= 1000; ++i) {
+        input.push_back(i);
+    }
+    auto result = parallel_traverse(input, [](int x) { return Result<int>::ok(x * 2); }, 4);
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().size() == 1000);
+    for (size_t i = 0; i < 1000; ++i) {
+        REQUIRE(result.value()[i] == static_cast<int>(i + 1) * 2);
+    }
+}
+
+TEST_CASE("parallel_traverse returns the first error in input order", "[traverse]") {
+    std::vector<int> input(200, 1);
+    input[150] = -150;
+    input[20] = -20;
+    input[90] = -90;
+    auto result = parallel_traverse(input, parse_positive, 8);
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "not positive: -20");
+}
+
+TEST_CASE("parallel_traverse runs Result<void> steps on all elements", "[traverse]") {
+    std::vector<int> input(64, 1);
+    std::atomic<int> sum{0};
+    auto result = parallel_traverse(
+        input,
+        [&sum](int x) {
+            sum += x;
+            return Result<void>::ok();
+        },
+        4);
+    REQUIRE(result.is_ok());
+    REQUIRE(sum == 64);
+}
+
+TEST_CASE("parallel_traverse of an empty range is ok", "[traverse]") {
+    std::vector<int> input;
+    auto result = parallel_traverse(input, parse_positive);
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().empty());
+}
+
+TEST_CASE("parallel_traverse rethrows a worker exception after joining", "[traverse]") {
+    std::vector<int> input(200, 1);
+    input[120] = -1;
+    auto throwing = [](int x) {
+        if (x < 0) {
+            throw std::runtime_error("boom");
+        }
+        return Result<int>::ok(x);
+    };
+    REQUIRE_THROWS_AS(parallel_traverse(input, throwing, 4), std::runtime_error);
+}
+
+TEST_CASE("parallel_traverse prefers an earlier error over a later exception", "[traverse]") {
+    std::vector<int> input(200, 1);
+    input[10] = -10;
+    input[150] = 0;
+    auto result = parallel_traverse(
+        input,
+        [](int x) {
+            if (x == 0) {
+                throw std::runtime_error("boom");
+            }
+            return parse_positive(x);
+        },
+        4);
+    REQUIRE(result.is_err());
+    REQUIRE(result.error() == "not positive: -10");
+}
+
+TEST_CASE("parallel_traverse runs small ranges on the calling thread", "[traverse]") {
+    std::vector<int> input(parallel_traverse_min_size - 1, 1);
+    auto caller = std::this_thread::get_id();
+    std::atomic<int> other_threads{0};
+    auto result = parallel_traverse(
+        input,
+        [&](int x) {
+            if (std::this_thread::get_id() != caller) {
+                ++other_threads;
+            }
+            return Result<int>::ok(x);
+        },
+        4);
+    REQUIRE(result.is_ok());
+    REQUIRE(result.value().size() == input.size());
+    REQUIRE(other_threads == 0);
+}
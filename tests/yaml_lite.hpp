@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "fp-cpp-init/result.hpp"
+
+// 测试用的最小 YAML 解析器：只覆盖生成的 workflow 用到的子集
+// （块映射、块序列、"- key: value" 序列项、| 块标量、[a, b] 流序列、引号标量）
+// 不支持锚点、多文档、行内注释等；遇到 tab 缩进或无法识别的行返回错误
+
+namespace yaml_lite {
+
+struct Node {
+    enum class Kind { Scalar, Map, Seq };
+
+    Kind kind = Kind::Scalar;
+    std::string scalar;
+    std::vector<std::pair<std::string, Node>> map;
+    std::vector<Node> seq;
+
+    auto is_map() const -> bool { return kind == Kind::Map; }
+
+    auto is_seq() const -> bool { return kind == Kind::Seq; }
+
+    auto has(std::string_view key) const -> bool {
+        return std::any_of(map.begin(), map.end(),
+                           [key](const auto& entry) { return entry.first == key; });
+    }
+
+    // 缺失的键返回空标量，便于链式访问
+    auto operator[](std::string_view key) const -> const Node& {
+        static const Node missing;
+        for (const auto& [k, v] : map) {
+            if (k == key) {
+                return v;
+            }
+        }
+        return missing;
+    }
+};
+
+namespace detail {
+
+struct Line {
+    size_t indent = 0;
+    std::string_view text; // 去掉缩进后的内容
+    bool ignorable = false; // 空行或整行注释
+};
+
+inline auto trim(std::string_view s) -> std::string_view {
+    auto begin = s.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    auto end = s.find_last_not_of(' ');
+    return s.substr(begin, end - begin + 1);
+}
+
+inline auto is_item(std::string_view text) -> bool {
+    return text == "-" || text.substr(0, 2) == "- ";
+}
+
+// "key: value" / "key:"，返回键的长度；不是映射项时返回 npos
+inline auto key_length(std::string_view text) -> size_t {
+    if (text.empty() || text[0] == '"' || text[0] == '\'' || text[0] == '[') {
+        return std::string_view::npos;
+    }
+    auto colon = text.find(": ");
+    if (colon == std::string_view::npos && text.back() == ':') {
+        colon = text.size() - 1;
+    }
+    return colon == 0 ? std::string_view::npos : colon;
+}
+
+inline auto scalar(std::string_view value) -> Node {
+    value = trim(value);
+    Node node;
+    if (value.size() >= 2 && value.front() == '[' && value.back() == ']') {
+        node.kind = Node::Kind::Seq;
+        auto items = value.substr(1, value.size() - 2);
+        while (!trim(items).empty()) {
+            auto comma = items.find(',');
+            node.seq.push_back(scalar(items.substr(0, comma)));
+            items = comma == std::string_view::npos ? std::string_view{} : items.substr(comma + 1);
+        }
+        return node;
+    }
+    if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') &&
+        value.back() == value.front()) {
+        value = value.substr(1, value.size() - 2);
+    }
+    node.scalar = std::string(value);
+    return node;
+}
+
+class Parser {
+  public:
+    explicit Parser(std::vector<Line> lines) : lines_(std::move(lines)) {}
+
+    auto parse_document() -> fp::Result<Node> {
+        skip_ignorable();
+        auto root = parse_node(0);
+        skip_ignorable();
+        if (!error_.empty()) {
+            return fp::Result<Node>::err(error_);
+        }
+        if (pos_ < lines_.size()) {
+            return fp::Result<Node>::err("unexpected line: " + std::string(lines_[pos_].text));
+        }
+        return fp::Result<Node>::ok(std::move(root));
+    }
+
+  private:
+    std::vector<Line> lines_;
+    size_t pos_ = 0;
+    std::string error_;
+
+    auto skip_ignorable() -> void {
+        while (pos_ < lines_.size() && lines_[pos_].ignorable) {
+            ++pos_;
+        }
+    }
+
+    auto parse_node(size_t min_indent) -> Node {
+        skip_ignorable();
+        if (pos_ >= lines_.size() || lines_[pos_].indent < min_indent) {
+            return Node{};
+        }
+        const auto& line = lines_[pos_];
+        return is_item(line.text) ? parse_seq(line.indent) : parse_map(line.indent);
+    }
+
+    auto parse_seq(size_t indent) -> Node {
+        Node node;
+        node.kind = Node::Kind::Seq;
+        for (skip_ignorable(); pos_ < lines_.size() && error_.empty(); skip_ignorable()) {
+            auto& line = lines_[pos_];
+            if (line.indent != indent || !is_item(line.text)) {
+                break;
+            }
+            auto rest = line.text.substr(1);
+            auto offset = rest.find_first_not_of(' ');
+            if (offset == std::string_view::npos) {
+                ++pos_;
+                node.seq.push_back(parse_node(indent + 1));
+            } else if (key_length(rest.substr(offset)) != std::string_view::npos) {
+                // "- key: value" 视为缩进到 key 处的映射
+                line.indent = indent + 1 + offset;
+                line.text = rest.substr(offset);
+                node.seq.push_back(parse_map(line.indent));
+            } else {
+                ++pos_;
+                node.seq.push_back(scalar(rest));
+            }
+        }
+        return node;
+    }
+
+    auto parse_map(size_t indent) -> Node {
+        Node node;
+        node.kind = Node::Kind::Map;
+        for (skip_ignorable(); pos_ < lines_.size() && error_.empty(); skip_ignorable()) {
+            const auto& line = lines_[pos_];
+            if (line.indent != indent || is_item(line.text)) {
+                if (line.indent > indent) {
+                    error_ = "bad indentation: " + std::string(line.text);
+                }
+                break;
+            }
+            auto key_len = key_length(line.text);
+            if (key_len == std::string_view::npos) {
+                error_ = "expected key: " + std::string(line.text);
+                break;
+            }
+            auto key = std::string(line.text.substr(0, key_len));
+            auto value = trim(line.text.substr(std::min(key_len + 1, line.text.size())));
+            ++pos_;
+
+            if (value == "|" || value == "|-" || value == ">") {
+                node.map.emplace_back(std::move(key), parse_block_scalar(indent));
+            } else if (!value.empty()) {
+                node.map.emplace_back(std::move(key), scalar(value));
+            } else {
+                // 子节点缩进更深，或是与键同缩进的序列
+                skip_ignorable();
+                bool has_child = pos_ < lines_.size() &&
+                                 (lines_[pos_].indent > indent ||
+                                  (lines_[pos_].indent == indent && is_item(lines_[pos_].text)));
+                node.map.emplace_back(std::move(key),
+                                      has_child ? parse_node(lines_[pos_].indent) : Node{});
+            }
+        }
+        return node;
+    }
+
+    // | 块标量：缩进大于父键的后续行（含其中的空行与 # 行），去掉公共缩进后以换行连接
+    auto parse_block_scalar(size_t parent_indent) -> Node {
+        Node node;
+        size_t block_indent = std::string_view::npos;
+        while (pos_ < lines_.size()) {
+            const auto& line = lines_[pos_];
+            bool blank = line.text.empty();
+            if (!blank && line.indent <= parent_indent) {
+                break;
+            }
+            if (!blank && block_indent == std::string_view::npos) {
+                block_indent = line.indent;
+            }
+            if (!blank) {
+                node.scalar.append(line.indent - block_indent, ' ');
+                node.scalar += line.text;
+            }
+            node.scalar += '\n';
+            ++pos_;
+        }
+        return node;
+    }
+};
+
+} // namespace detail
+
+// 纯函数：解析 YAML 文本
+inline auto parse(std::string_view text) -> fp::Result<Node> {
+    std::vector<detail::Line> lines;
+    while (!text.empty()) {
+        auto end = text.find('\n');
+        auto raw = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1);
+        if (!raw.empty() && raw.back() == '\r') {
+            raw.remove_suffix(1);
+        }
+        auto indent = raw.find_first_not_of(' ');
+        if (indent != std::string_view::npos && raw[indent] == '\t') {
+            return fp::Result<Node>::err("tab indentation is not allowed");
+        }
+        detail::Line line;
+        line.indent = indent == std::string_view::npos ? 0 : indent;
+        line.text = indent == std::string_view::npos ? std::string_view{} : raw.substr(indent);
+        line.ignorable = line.text.empty() || line.text.front() == '#';
+        lines.push_back(line);
+    }
+    return detail::Parser(std::move(lines)).parse_document();
+}
+
+} // namespace yaml_lite